@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+    AnalyzerFifo.h
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    A wait-free single-producer/single-consumer queue that carries a mono
+    mixdown of the audio from processBlock to the spectrum analysis thread.
+
+    The audio thread never waits for the reader: whatever doesn't fit is
+    dropped, which only costs the analyzer a few samples of history.
+
+    The storage is only allocated once a reader turns up, so instances that
+    never open an analyzer don't carry it.
+*/
+class AnalyzerFifo
+{
+public:
+	explicit AnalyzerFifo (int capacity = 1 << 15)
+		: fifo(capacity)
+	{
+	}
+	
+	/** Allocates the storage if it isn't already. Must happen before the audio
+		thread is allowed to push, and never while it might be.
+	*/
+	void allocate()
+	{
+		if (samples.empty())
+			samples.resize((size_t) fifo.getTotalSize());
+	}
+	
+	/** Audio thread: mixes every channel down to mono and appends it. */
+	template <typename SampleType>
+	void push (const juce::AudioBuffer<SampleType>& audio) noexcept
+	{
+		const auto numChannels = audio.getNumChannels();
+		const auto numToWrite = juce::jmin(audio.getNumSamples(), fifo.getFreeSpace());
+		
+		if (numChannels == 0 || numToWrite <= 0)
+			return;
+		
+		int start1, size1, start2, size2;
+		fifo.prepareToWrite(numToWrite, start1, size1, start2, size2);
+		
+		const auto gain = 1.f / (float) numChannels;
+		
+		auto mixDown = [&] (int destinationStart, int sourceStart, int numSamples)
+		{
+			auto* destination = samples.data() + destinationStart;
+			
+			if constexpr (std::is_same<SampleType, float>::value)
+			{
+				juce::FloatVectorOperations::copyWithMultiply(destination, audio.getReadPointer(0, sourceStart), gain, numSamples);
+				
+				for (int channel = 1; channel < numChannels; ++channel)
+					juce::FloatVectorOperations::addWithMultiply(destination, audio.getReadPointer(channel, sourceStart), gain, numSamples);
+			}
+			else
+			{
+				std::fill_n(destination, numSamples, 0.f);
+				
+				for (int channel = 0; channel < numChannels; ++channel)
+				{
+					const auto* source = audio.getReadPointer(channel, sourceStart);
+					
+					for (int i = 0; i < numSamples; ++i)
+						destination[i] += gain * (float) source[i];
+				}
+			}
+		};
+		
+		if (size1 > 0)
+			mixDown(start1, 0, size1);
+		
+		if (size2 > 0)
+			mixDown(start2, size1, size2);
+		
+		fifo.finishedWrite(size1 + size2);
+	}
+	
+	/** Reader side: copies up to maxSamples out and returns how many there were. */
+	int pull (float* destination, int maxSamples) noexcept
+	{
+		int start1, size1, start2, size2;
+		fifo.prepareToRead(maxSamples, start1, size1, start2, size2);
+		
+		if (size1 > 0)
+			std::copy_n(samples.data() + start1, size1, destination);
+		
+		if (size2 > 0)
+			std::copy_n(samples.data() + start2, size2, destination + size1);
+		
+		fifo.finishedRead(size1 + size2);
+		return size1 + size2;
+	}
+	
+private:
+	juce::AbstractFifo fifo;
+	std::vector<float> samples;
+	
+	JUCE_DECLARE_NON_COPYABLE (AnalyzerFifo)
+};
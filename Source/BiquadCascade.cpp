@@ -0,0 +1,206 @@
+/*
+  ==============================================================================
+
+    BiquadCascade.cpp
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#include "BiquadCascade.h"
+
+// The sample loop is plain SIMDRegister arithmetic at the width the plugin is
+// built for: SSE2 on x86, NEON on ARM. There is deliberately no runtime choice
+// of instruction set, so a given binary renders bit-identical output on every
+// machine it runs on; x86 builds also have no FMA to contract into. Output can
+// still differ in the last bits between an x86 and an ARM build.
+template <typename StateType>
+const char* BiquadCascade<StateType>::getInstructionSetName() noexcept
+{
+   #if JUCE_USE_SIMD && JUCE_ARM
+	return "NEON";
+   #elif JUCE_USE_SIMD
+	return "SSE2";
+   #else
+	return "Scalar";
+   #endif
+}
+
+//==============================================================================
+template <typename StateType>
+BiquadCascade<StateType>::BiquadCascade()
+{
+	activeIndex.fill(-1);
+	
+	for (int i = 0; i < maxNumSections; ++i)
+		setSection(i, { 1.0, 0.0, 0.0, 1.0, 0.0, 0.0 });
+	
+	reset();
+}
+
+template <typename StateType>
+void BiquadCascade<StateType>::prepare (const juce::dsp::ProcessSpec& spec)
+{
+	jassert(spec.numChannels <= maxNumChannels);
+	juce::ignoreUnused(spec);
+	
+	reset();
+}
+
+template <typename StateType>
+void BiquadCascade<StateType>::reset()
+{
+	s1.fill(Register::expand(0));
+	s2.fill(Register::expand(0));
+}
+
+template <typename StateType>
+void BiquadCascade<StateType>::setSection (int index, const Coefficients& coefficients) noexcept
+{
+	const auto slot = (size_t) index;
+	sections.b0[slot] = Register::expand(static_cast<StateType>(coefficients[0]));
+	sections.b1[slot] = Register::expand(static_cast<StateType>(coefficients[1]));
+	sections.b2[slot] = Register::expand(static_cast<StateType>(coefficients[2]));
+	sections.a1[slot] = Register::expand(static_cast<StateType>(coefficients[4]));
+	sections.a2[slot] = Register::expand(static_cast<StateType>(coefficients[5]));
+	
+	updateActiveSection(slot);
+}
+
+template <typename StateType>
+void BiquadCascade<StateType>::setSection (int index, size_t lane, const Coefficients& coefficients) noexcept
+{
+	jassert(lane < maxNumChannels);
+	
+	const auto slot = (size_t) index;
+	sections.b0[slot].set(lane, static_cast<StateType>(coefficients[0]));
+	sections.b1[slot].set(lane, static_cast<StateType>(coefficients[1]));
+	sections.b2[slot].set(lane, static_cast<StateType>(coefficients[2]));
+	sections.a1[slot].set(lane, static_cast<StateType>(coefficients[4]));
+	sections.a2[slot].set(lane, static_cast<StateType>(coefficients[5]));
+	
+	updateActiveSection(slot);
+}
+
+template <typename StateType>
+void BiquadCascade<StateType>::updateActiveSection (size_t slot) noexcept
+{
+	const auto position = activeIndex[slot];
+	
+	if (position < 0)
+		return;
+	
+	const auto k = (size_t) position;
+	active.b0[k] = sections.b0[slot];
+	active.b1[k] = sections.b1[slot];
+	active.b2[k] = sections.b2[slot];
+	active.a1[k] = sections.a1[slot];
+	active.a2[k] = sections.a2[slot];
+}
+
+template <typename StateType>
+void BiquadCascade<StateType>::setSectionEnabled (int index, bool shouldBeEnabled) noexcept
+{
+	if (enabled[(size_t) index] == shouldBeEnabled)
+		return;
+	
+	enabled[(size_t) index] = shouldBeEnabled;
+	updateEnabledSections();
+}
+
+template <typename StateType>
+bool BiquadCascade<StateType>::hasDenormalState() const noexcept
+{
+	for (size_t k = 0; k < (size_t) numEnabledSections; ++k)
+		for (size_t lane = 0; lane < Register::SIMDNumElements; ++lane)
+			if (std::fpclassify(s1[k].get(lane)) == FP_SUBNORMAL || std::fpclassify(s2[k].get(lane)) == FP_SUBNORMAL)
+				return true;
+	
+	return false;
+}
+
+template <typename StateType>
+void BiquadCascade<StateType>::updateEnabledSections() noexcept
+{
+	// Sections that stay enabled keep their state as they move up or down the
+	// packed arrays; newly enabled ones start from silence.
+	const auto previousS1 = s1, previousS2 = s2;
+	size_t k = 0;
+	
+	for (size_t slot = 0; slot < (size_t) maxNumSections; ++slot)
+	{
+		const auto previous = activeIndex[slot];
+		
+		if (! enabled[slot])
+		{
+			activeIndex[slot] = -1;
+			continue;
+		}
+		
+		s1[k] = previous >= 0 ? previousS1[(size_t) previous] : Register::expand(0);
+		s2[k] = previous >= 0 ? previousS2[(size_t) previous] : Register::expand(0);
+		activeIndex[slot] = (int) k++;
+		updateActiveSection(slot);
+	}
+	
+	numEnabledSections = (int) k;
+}
+
+template <typename StateType>
+template <typename SampleType>
+void BiquadCascade<StateType>::processSamples (SampleType* const* channels, size_t numChannels, size_t numSamples) noexcept
+{
+	// Unused lanes stay at zero, so they never build up state of their own.
+	alignas (Register::SIMDRegisterSize) StateType frame[maxNumChannels] {};
+	
+	for (size_t i = 0; i < numSamples; ++i)
+	{
+		for (size_t channel = 0; channel < numChannels; ++channel)
+			frame[channel] = static_cast<StateType>(channels[channel][i]);
+		
+		auto x = Register::fromRawArray(frame);
+		
+		for (size_t k = 0; k < (size_t) numEnabledSections; ++k)
+		{
+			const auto y = active.b0[k] * x + s1[k];
+			s1[k] = active.b1[k] * x - active.a1[k] * y + s2[k];
+			s2[k] = active.b2[k] * x - active.a2[k] * y;
+			x = y;
+		}
+		
+		x.copyToRawArray(frame);
+		
+		for (size_t channel = 0; channel < numChannels; ++channel)
+			channels[channel][i] = static_cast<SampleType>(frame[channel]);
+	}
+}
+
+template <typename StateType>
+template <typename SampleType>
+void BiquadCascade<StateType>::process (const juce::dsp::ProcessContextReplacing<SampleType>& context) noexcept
+{
+	auto&& block = context.getOutputBlock();
+	const auto numChannels = juce::jmin(block.getNumChannels(), maxNumChannels);
+	const auto numSamples = block.getNumSamples();
+	
+	if (numEnabledSections == 0 || context.isBypassed)
+		return;
+	
+	std::array<SampleType*, maxNumChannels> channels {};
+	
+	for (size_t channel = 0; channel < numChannels; ++channel)
+		channels[channel] = block.getChannelPointer(channel);
+	
+	processSamples(channels.data(), numChannels, numSamples);
+}
+
+//==============================================================================
+template class BiquadCascade<float>;
+template class BiquadCascade<double>;
+
+// Float state with float audio, double state with either: the last of these
+// is the mixed-precision path, for hosts that only hand over float buffers.
+template void BiquadCascade<float>::process (const juce::dsp::ProcessContextReplacing<float>&) noexcept;
+template void BiquadCascade<double>::process (const juce::dsp::ProcessContextReplacing<double>&) noexcept;
+template void BiquadCascade<double>::process (const juce::dsp::ProcessContextReplacing<float>&) noexcept;
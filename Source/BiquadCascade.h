@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    BiquadCascade.h
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Raw biquad coefficients (b0, b1, b2, a0, a1, a2), normalised so that a0 == 1.
+// Designing into these instead of IIR::Coefficients keeps the design step free
+// of heap allocations, and the normalised form can be interpolated safely.
+// They are designed in double; each cascade rounds them to its own precision.
+using Coefficients = std::array<double, 6>;
+
+//==============================================================================
+/**
+    A cascade of transposed direct form II biquads that filters several channels
+    at once, one channel per lane of a juce::dsp::SIMDRegister.
+
+    Channels normally share the same coefficients, so a stereo signal costs the
+    same as a mono one. Each lane can also be given coefficients of its own, to
+    run unrelated filters side by side; see MultiStreamEQ.
+
+    Sections live in fixed slots, and the enabled ones are packed, in slot
+    order, into contiguous arrays of coefficients and state, so a single pass
+    over the block visits only those with nothing in between.
+
+    StateType is the precision of the coefficients and filter state, and with
+    it the number of lanes. The audio passing through can be float or double
+    either way, so a float host buffer can still run through double state.
+*/
+template <typename StateType>
+class BiquadCascade
+{
+public:
+	using Register = juce::dsp::SIMDRegister<StateType>;
+	
+	static constexpr int maxNumSections = 16;
+	static constexpr size_t maxNumChannels = Register::SIMDNumElements;
+	
+	BiquadCascade();
+	
+	void prepare (const juce::dsp::ProcessSpec& spec);
+	void reset();
+	
+	/** Filters every channel of the context's block in place. */
+	template <typename SampleType>
+	void process (const juce::dsp::ProcessContextReplacing<SampleType>& context) noexcept;
+	
+	void setSection (int index, const Coefficients& coefficients) noexcept;
+	
+	/** Sets a section for one lane only. Enabling is still shared: a section is
+		run for every lane or for none, so a lane that doesn't need it should be
+		given unity coefficients.
+	*/
+	void setSection (int index, size_t lane, const Coefficients& coefficients) noexcept;
+	
+	/** Disabled sections are skipped entirely; their state is cleared so they
+		start from silence when enabled again.
+	*/
+	void setSectionEnabled (int index, bool shouldBeEnabled) noexcept;
+	bool isSectionEnabled (int index) const noexcept	{ return enabled[(size_t) index]; }
+	
+	int getNumEnabledSections() const noexcept			{ return numEnabledSections; }
+	
+	/** True if any enabled section's state has gone subnormal. With flush-to-zero
+		on, as processBlock() sets it, this should never happen; it's a diagnostic.
+	*/
+	bool hasDenormalState() const noexcept;
+	
+	/** The instruction set the sample loop was built for: "SSE2", "NEON", or
+		"Scalar" where juce::dsp::SIMDRegister has no native registers.
+	*/
+	static const char* getInstructionSetName() noexcept;
+	
+private:
+	// Structure of arrays: each coefficient of every section, side by side.
+	struct SectionArrays
+	{
+		std::array<Register, maxNumSections> b0, b1, b2, a1, a2;
+	};
+	
+	SectionArrays sections;		// by slot
+	SectionArrays active;		// the enabled sections, packed in slot order
+	std::array<Register, maxNumSections> s1, s2;	// state of the packed sections
+	
+	std::array<bool, maxNumSections> enabled {};
+	std::array<int, maxNumSections> activeIndex {};	// slot to packed position, or -1
+	int numEnabledSections { 0 };
+	
+	void updateEnabledSections() noexcept;
+	void updateActiveSection (size_t slot) noexcept;
+	
+	template <typename SampleType>
+	void processSamples (SampleType* const* channels, size_t numChannels, size_t numSamples) noexcept;
+	
+	JUCE_LEAK_DETECTOR (BiquadCascade)
+};
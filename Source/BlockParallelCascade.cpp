@@ -0,0 +1,270 @@
+/*
+  ==============================================================================
+
+    BlockParallelCascade.cpp
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#include "BlockParallelCascade.h"
+
+// Runs task(0) ... task(numTasks - 1) on the pool and waits for all of them.
+template <typename Task>
+static void runInParallel (juce::ThreadPool& pool, int numTasks, Task&& task)
+{
+	std::atomic<int> numRemaining { numTasks };
+	juce::WaitableEvent finished;
+	
+	for (int i = 0; i < numTasks; ++i)
+	{
+		pool.addJob([&, i]
+		{
+			task(i);
+			
+			if (--numRemaining == 0)
+				finished.signal();
+		});
+	}
+	
+	finished.wait();
+}
+
+//==============================================================================
+void BlockParallelCascade::prepare (int numChannels, int maxNumSamples)
+{
+	channelStates.assign((size_t) numChannels, State {});
+	scratch.assign((size_t) numChannels, std::vector<double> ((size_t) maxNumSamples));
+}
+
+void BlockParallelCascade::setChain (const ChainCoefficients& chainCoefficients)
+{
+	numSections = 0;
+	
+	auto addSection = [this] (const Coefficients& coefficients)
+	{
+		sections[(size_t) numSections++] = { coefficients[0], coefficients[1], coefficients[2], coefficients[4], coefficients[5] };
+	};
+	
+	// Slot order, as AwesomeEQAudioProcessor::applyCoefficients() lays the cascade out.
+	for (int i = 0; i < getNumCutSections(chainCoefficients.lowCutSlope); ++i)
+		addSection(chainCoefficients.lowCut[(size_t) i]);
+	
+	for (size_t i = 0; i < chainCoefficients.bands.size(); ++i)
+		if (chainCoefficients.enabledBands[i])
+			addSection(chainCoefficients.bands[i]);
+	
+	for (int i = 0; i < getNumCutSections(chainCoefficients.highCutSlope); ++i)
+		addSection(chainCoefficients.highCut[(size_t) i]);
+	
+	reset();
+}
+
+void BlockParallelCascade::reset()
+{
+	for (auto& state : channelStates)
+		state.fill(0.0);
+}
+
+//==============================================================================
+void BlockParallelCascade::filter (State& state, double* samples, int numSamples) const noexcept
+{
+	// The same transposed direct form II, in the same order, as BiquadCascade.
+	for (int i = 0; i < numSamples; ++i)
+	{
+		auto x = samples[i];
+		
+		for (size_t k = 0; k < (size_t) numSections; ++k)
+		{
+			const auto& section = sections[k];
+			auto& s1 = state[2 * k];
+			auto& s2 = state[2 * k + 1];
+			
+			const auto y = section.b0 * x + s1;
+			s1 = section.b1 * x - section.a1 * y + s2;
+			s2 = section.b2 * x - section.a2 * y;
+			x = y;
+		}
+		
+		samples[i] = x;
+	}
+}
+
+void BlockParallelCascade::addZeroInputResponse (State state, double* samples, int numSamples) const noexcept
+{
+	// Once every state is below 1e-15 what's left is under -300 dB.
+	constexpr double threshold = 1.0e-15;
+	constexpr int checkInterval = 32;
+	const auto numStates = (size_t) (2 * numSections);
+	
+	for (int i = 0; i < numSamples; ++i)
+	{
+		if (i % checkInterval == 0)
+		{
+			double largest = 0.0;
+			
+			for (size_t k = 0; k < numStates; ++k)
+				largest = juce::jmax(largest, std::abs(state[k]));
+			
+			if (largest < threshold)
+				return;
+		}
+		
+		double x = 0.0;
+		
+		for (size_t k = 0; k < (size_t) numSections; ++k)
+		{
+			const auto& section = sections[k];
+			auto& s1 = state[2 * k];
+			auto& s2 = state[2 * k + 1];
+			
+			const auto y = section.b0 * x + s1;
+			s1 = section.b1 * x - section.a1 * y + s2;
+			s2 = section.b2 * x - section.a2 * y;
+			x = y;
+		}
+		
+		samples[i] += x;
+	}
+}
+
+BlockParallelCascade::Matrix BlockParallelCascade::getTransitionMatrix (int numSamples) const
+{
+	const auto n = (size_t) (2 * numSections);
+	
+	auto multiply = [n] (const Matrix& left, const Matrix& right)
+	{
+		Matrix product (n * n, 0.0);
+		
+		for (size_t row = 0; row < n; ++row)
+			for (size_t k = 0; k < n; ++k)
+				if (const auto value = left[row * n + k]; value != 0.0)
+					for (size_t column = 0; column < n; ++column)
+						product[row * n + column] += value * right[k * n + column];
+		
+		return product;
+	};
+	
+	// One step with no input, taken from each unit state in turn: column j is
+	// where state j ends up after a sample.
+	Matrix step (n * n, 0.0);
+	
+	for (size_t j = 0; j < n; ++j)
+	{
+		State state {};
+		state[j] = 1.0;
+		
+		double sample = 0.0;
+		filter(state, &sample, 1);
+		
+		for (size_t row = 0; row < n; ++row)
+			step[row * n + j] = state[row];
+	}
+	
+	Matrix result (n * n, 0.0);
+	
+	for (size_t i = 0; i < n; ++i)
+		result[i * n + i] = 1.0;
+	
+	for (auto remaining = (unsigned int) numSamples; remaining > 0; remaining >>= 1)
+	{
+		if ((remaining & 1) != 0)
+			result = multiply(result, step);
+		
+		if (remaining > 1)
+			step = multiply(step, step);
+	}
+	
+	return result;
+}
+
+BlockParallelCascade::State BlockParallelCascade::transition (const Matrix& matrix, const State& state) const noexcept
+{
+	const auto n = (size_t) (2 * numSections);
+	State result {};
+	
+	for (size_t row = 0; row < n; ++row)
+		for (size_t column = 0; column < n; ++column)
+			result[row] += matrix[row * n + column] * state[column];
+	
+	return result;
+}
+
+//==============================================================================
+void BlockParallelCascade::process (float* const* channels, int numChannels, int numSamples, juce::ThreadPool& pool, int numChunks)
+{
+	jassert(numChannels <= (int) channelStates.size());
+	jassert(scratch.empty() || numSamples <= (int) scratch.front().size());
+	
+	if (numSections == 0 || numSamples <= 0 || numChannels <= 0)
+		return;
+	
+	const auto maxNumChunks = juce::jlimit(1, numSamples, numChunks);
+	const auto chunkLength = (numSamples + maxNumChunks - 1) / maxNumChunks;
+	numChunks = (numSamples + chunkLength - 1) / chunkLength;
+	const auto lastChunkLength = numSamples - (numChunks - 1) * chunkLength;
+	const auto numTasks = numChannels * numChunks;
+	
+	auto getChunkLength = [&] (int chunk) { return chunk == numChunks - 1 ? lastChunkLength : chunkLength; };
+	
+	// Every chunk from silence, except the first, which carries on from the last call.
+	std::vector<State> chunkStates ((size_t) numTasks);
+	
+	runInParallel(pool, numTasks, [&] (int task)
+	{
+		juce::ScopedNoDenormals noDenormals;
+		
+		const auto channel = task / numChunks, chunk = task % numChunks;
+		const auto offset = chunk * chunkLength, length = getChunkLength(chunk);
+		auto* samples = scratch[(size_t) channel].data() + offset;
+		
+		for (int i = 0; i < length; ++i)
+			samples[i] = (double) channels[channel][offset + i];
+		
+		auto state = chunk == 0 ? channelStates[(size_t) channel] : State {};
+		filter(state, samples, length);
+		chunkStates[(size_t) task] = state;
+	});
+	
+	// The scan. It's serial, but only one small matrix-vector product per chunk.
+	// Afterwards chunkStates holds the state each chunk should have started in.
+	const auto chunkTransition = getTransitionMatrix(chunkLength);
+	const auto lastChunkTransition = lastChunkLength == chunkLength ? chunkTransition : getTransitionMatrix(lastChunkLength);
+	
+	for (int channel = 0; channel < numChannels; ++channel)
+	{
+		auto state = chunkStates[(size_t) (channel * numChunks)];
+		chunkStates[(size_t) (channel * numChunks)] = channelStates[(size_t) channel];
+		
+		for (int chunk = 1; chunk < numChunks; ++chunk)
+		{
+			const auto task = (size_t) (channel * numChunks + chunk);
+			const auto endFromSilence = chunkStates[task];
+			const auto endFromStart = transition(chunk == numChunks - 1 ? lastChunkTransition : chunkTransition, state);
+			
+			chunkStates[task] = state;
+			
+			for (size_t k = 0; k < state.size(); ++k)
+				state[k] = endFromStart[k] + endFromSilence[k];
+		}
+		
+		channelStates[(size_t) channel] = state;
+	}
+	
+	// Each chunk but the first gets the ringing of its true starting state.
+	runInParallel(pool, numTasks, [&] (int task)
+	{
+		juce::ScopedNoDenormals noDenormals;
+		
+		const auto channel = task / numChunks, chunk = task % numChunks;
+		const auto offset = chunk * chunkLength, length = getChunkLength(chunk);
+		auto* samples = scratch[(size_t) channel].data() + offset;
+		
+		if (chunk > 0)
+			addZeroInputResponse(chunkStates[(size_t) task], samples, length);
+		
+		for (int i = 0; i < length; ++i)
+			channels[channel][offset + i] = (float) samples[i];
+	});
+}
@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    BlockParallelCascade.h
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BiquadCascade.h"
+#include "ChainDesign.h"
+
+//==============================================================================
+/**
+    The minimum-phase chain for offline rendering, spread over several threads
+    by splitting long buffers into chunks.
+
+    Every chunk is first filtered from silence, all of them at once. The chain
+    is linear, so the only thing that gets wrong is the ringing of the state
+    the chunk should have started with, i.e. its zero-input response. Those
+    starting states follow from a scan over the chunks,
+
+        s[c + 1] = A^L s[c] + e[c]
+
+    where e[c] is the state chunk c ended in from silence and A^L is the
+    whole chain's state transition over the L samples of a chunk, found by
+    repeated squaring. A second parallel pass then adds each chunk's
+    zero-input response, stopping once it has decayed below -300 dB.
+
+    State, coefficients and the arithmetic are double throughout, and samples
+    are converted once on the way in and out, so the output matches the serial
+    double-precision path to within rounding: around 1e-13 or better before the
+    final conversion, which leaves float output equal, or at worst one ulp apart.
+
+    Calls carry on from one another as a serial filter would, so a long file
+    can be processed a segment at a time.
+*/
+class BlockParallelCascade
+{
+public:
+	BlockParallelCascade() = default;
+	
+	/** A chunk length long enough that the ringing each chunk inherits is only
+		a small part of its work.
+	*/
+	static constexpr int preferredChunkLength = 1 << 17;
+	
+	/** Allocates the state and scratch space. Not realtime-safe, like the rest of this class. */
+	void prepare (int numChannels, int maxNumSamples);
+	
+	/** Takes the sections the processor would enable for this design, in the
+		same order, and starts again from silence.
+	*/
+	void setChain (const ChainCoefficients& chainCoefficients);
+	
+	void reset();
+	
+	/** Filters every channel in place, in up to numChunks chunks per channel,
+		running on the given pool and waiting for it. Mustn't be called from
+		one of the pool's own threads.
+	*/
+	void process (float* const* channels, int numChannels, int numSamples, juce::ThreadPool& pool, int numChunks);
+	
+	int getNumSections() const noexcept		{ return numSections; }
+
+private:
+	static constexpr int maxNumStates = 2 * BiquadCascade<double>::maxNumSections;
+	
+	struct Section
+	{
+		double b0, b1, b2, a1, a2;
+	};
+	
+	// Both states of each section, s1 then s2, section by section.
+	using State = std::array<double, (size_t) maxNumStates>;
+	
+	// A square matrix over the chain's states, row by row.
+	using Matrix = std::vector<double>;
+	
+	std::array<Section, (size_t) BiquadCascade<double>::maxNumSections> sections {};
+	int numSections { 0 };
+	
+	std::vector<State> channelStates;
+	std::vector<std::vector<double>> scratch;
+	
+	void filter (State& state, double* samples, int numSamples) const noexcept;
+	void addZeroInputResponse (State state, double* samples, int numSamples) const noexcept;
+	
+	Matrix getTransitionMatrix (int numSamples) const;
+	State transition (const Matrix& matrix, const State& state) const noexcept;
+	
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BlockParallelCascade)
+};
@@ -0,0 +1,335 @@
+/*
+  ==============================================================================
+
+    ChainDesign.cpp
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#include "ChainDesign.h"
+
+//==============================================================================
+static Coefficients normalise (Coefficients coefficients)
+{
+	const auto a0Inverse = 1.0 / coefficients[3];
+	
+	for (auto& coefficient : coefficients)
+		coefficient *= a0Inverse;
+	
+	return coefficients;
+}
+
+Coefficients makeBandFilter (const BandSettings& band, double sampleRate)
+{
+	using ArrayCoefficients = juce::dsp::IIR::ArrayCoefficients<double>;
+	
+	const auto frequency = (double) band.freq, quality = (double) band.quality;
+	const auto gain = juce::Decibels::decibelsToGain((double) band.gainInDecibels);
+	
+	switch (band.type)
+	{
+		case Band_LowShelf:		return normalise(ArrayCoefficients::makeLowShelf(sampleRate, frequency, quality, gain));
+		case Band_HighShelf:	return normalise(ArrayCoefficients::makeHighShelf(sampleRate, frequency, quality, gain));
+		case Band_Notch:		return normalise(ArrayCoefficients::makeNotch(sampleRate, frequency, quality));
+		case Band_Bell:
+		default:				return normalise(ArrayCoefficients::makePeakFilter(sampleRate, frequency, quality, gain));
+	}
+}
+
+Coefficients makeMatchedPeakFilter (const BandSettings& band, double sampleRate)
+{
+	// Same prototype as a bell band: H(s) = (s^2 + s A/Q + 1) / (s^2 + s / (A Q) + 1), A = sqrt(gain).
+	const auto gain = juce::Decibels::decibelsToGain((double) band.gainInDecibels);
+	const auto w0 = juce::MathConstants<double>::twoPi * (double) band.freq / sampleRate;
+	const auto zeta = 1.0 / (2.0 * (double) band.quality * std::sqrt(gain));
+	
+	const auto decay = std::exp(-zeta * w0);
+	const auto a1 = zeta <= 1.0 ? -2.0 * decay * std::cos(std::sqrt(1.0 - zeta * zeta) * w0)
+								: -2.0 * decay * std::cosh(std::sqrt(zeta * zeta - 1.0) * w0);
+	const auto a2 = decay * decay;
+	
+	const auto A0 = (1.0 + a1 + a2) * (1.0 + a1 + a2);
+	const auto A1 = (1.0 - a1 + a2) * (1.0 - a1 + a2);
+	const auto A2 = -4.0 * a2;
+	
+	const auto phi1 = std::pow(std::sin(w0 / 2.0), 2.0);
+	const auto phi0 = 1.0 - phi1;
+	const auto phi2 = 4.0 * phi0 * phi1;
+	
+	const auto R1 = (A0 * phi0 + A1 * phi1 + A2 * phi2) * gain * gain;
+	const auto R2 = (-A0 + A1 + 4.0 * (phi0 - phi1) * A2) * gain * gain;
+	
+	const auto B0 = A0;
+	const auto B2 = (R1 - R2 * phi1 - B0) / (4.0 * phi1 * phi1);
+	const auto B1 = R2 + B0 + 4.0 * (phi1 - phi0) * B2;
+	
+	const auto W = 0.5 * (std::sqrt(B0) + std::sqrt(B1));
+	const auto b0 = 0.5 * (W + std::sqrt(W * W + B2));
+	const auto b1 = 0.5 * (std::sqrt(B0) - std::sqrt(B1));
+	const auto b2 = -B2 / (4.0 * b0);
+	
+	return { b0, b1, b2, 1.0, a1, a2 };
+}
+
+int getNumCutSections (Slope slope)
+{
+	return static_cast<int>(slope) + 1;
+}
+
+void applyMagnitudeResponse (const Coefficients& coefficients, const double* frequencies, double* magnitudes, size_t numFrequencies, double sampleRate)
+{
+	// Same evaluation as IIR::Coefficients::getMagnitudeForFrequencyArray, for
+	// the plain arrays the cascade runs on.
+	const auto b0 = (double) coefficients[0], b1 = (double) coefficients[1], b2 = (double) coefficients[2];
+	const auto a0 = (double) coefficients[3], a1 = (double) coefficients[4], a2 = (double) coefficients[5];
+	
+	for (size_t i = 0; i < numFrequencies; ++i)
+	{
+		const auto z = std::polar(1.0, -juce::MathConstants<double>::twoPi * frequencies[i] / sampleRate);
+		const auto numerator = b0 + z * (b1 + z * b2);
+		const auto denominator = a0 + z * (a1 + z * a2);
+		
+		magnitudes[i] *= std::abs(numerator / denominator);
+	}
+}
+
+static double getAnalogBandMagnitude (const BandSettings& band, double frequency)
+{
+	// The RBJ cookbook prototypes, with A = sqrt(gain) and s normalised to the band frequency.
+	const auto A = std::sqrt(juce::Decibels::decibelsToGain((double) band.gainInDecibels));
+	const auto Q = (double) band.quality;
+	const auto rootA = std::sqrt(A);
+	const std::complex<double> s (0.0, frequency / (double) band.freq);
+	
+	switch (band.type)
+	{
+		case Band_LowShelf:		return std::abs(A * (s * s + s * (rootA / Q) + A) / (A * s * s + s * (rootA / Q) + 1.0));
+		case Band_HighShelf:	return std::abs(A * (A * s * s + s * (rootA / Q) + 1.0) / (s * s + s * (rootA / Q) + A));
+		case Band_Notch:		return std::abs((s * s + 1.0) / (s * s + s / Q + 1.0));
+		case Band_Bell:
+		default:				return std::abs((s * s + s * (A / Q) + 1.0) / (s * s + s / (A * Q) + 1.0));
+	}
+}
+
+void getAnalogMagnitudeResponse (const ChannelSettings& channelSettings, const double* frequencies, double* magnitudes, size_t numFrequencies)
+{
+	const auto lowCutOrder = 2.0 * getNumCutSections(channelSettings.lowCutSlope);
+	const auto highCutOrder = 2.0 * getNumCutSections(channelSettings.highCutSlope);
+	
+	for (size_t i = 0; i < numFrequencies; ++i)
+	{
+		const auto frequency = frequencies[i];
+		
+		if (frequency <= 0.0)
+		{
+			magnitudes[i] = 0.0;
+			continue;
+		}
+		
+		auto bands = 1.0;
+		
+		for (const auto& band : channelSettings.bands)
+			if (band.enabled)
+				bands *= getAnalogBandMagnitude(band, frequency);
+		
+		const auto lowCut = 1.0 / std::sqrt(1.0 + std::pow((double) channelSettings.lowCutFreq / frequency, 2.0 * lowCutOrder));
+		const auto highCut = 1.0 / std::sqrt(1.0 + std::pow(frequency / (double) channelSettings.highCutFreq, 2.0 * highCutOrder));
+		
+		magnitudes[i] = bands * lowCut * highCut;
+	}
+}
+
+double getRingingTimeSeconds (const ChannelSettings& channelSettings)
+{
+	// A pole pair with quality Q at f decays as exp(-pi f t / Q), so it takes
+	// ln(1000) Q / (pi f) seconds to fall by 60 dB.
+	auto getDecayTime = [] (double frequency, double quality)
+	{
+		return frequency > 0.0 ? std::log(1000.0) * quality / (juce::MathConstants<double>::pi * frequency) : 0.0;
+	};
+	
+	// The highest section Q of a Butterworth cascade of the given order.
+	auto getButterworthQ = [] (Slope slope)
+	{
+		const auto order = 2 * getNumCutSections(slope);
+		return 1.0 / (2.0 * std::sin(juce::MathConstants<double>::pi / (2.0 * order)));
+	};
+	
+	// A bell's poles have quality A Q at its centre; a shelf's keep Q but sit a
+	// factor of sqrt(A) below (low shelf) or above (high shelf) its corner.
+	auto getBandDecayTime = [&getDecayTime] (const BandSettings& band)
+	{
+		if (! band.enabled || (band.type != Band_Notch && band.gainInDecibels == 0.f))
+			return 0.0;
+		
+		const auto A = std::sqrt(juce::Decibels::decibelsToGain((double) band.gainInDecibels));
+		const auto frequency = (double) band.freq, quality = (double) band.quality;
+		
+		switch (band.type)
+		{
+			case Band_LowShelf:		return getDecayTime(frequency / std::sqrt(A), quality);
+			case Band_HighShelf:	return getDecayTime(frequency * std::sqrt(A), quality);
+			case Band_Notch:		return getDecayTime(frequency, quality);
+			case Band_Bell:
+			default:				return getDecayTime(frequency, quality * A);
+		}
+	};
+	
+	auto ringingTime = juce::jmax(getDecayTime(channelSettings.lowCutFreq, getButterworthQ(channelSettings.lowCutSlope)),
+								  getDecayTime(channelSettings.highCutFreq, getButterworthQ(channelSettings.highCutSlope)));
+	
+	for (const auto& band : channelSettings.bands)
+		ringingTime = juce::jmax(ringingTime, getBandDecayTime(band));
+	
+	return ringingTime;
+}
+
+static CutCoefficients makeButterworthCascade (float frequency, Slope slope, double sampleRate, bool isHighPass)
+{
+	// Same Butterworth cascade as FilterDesign::designIIR...HighOrderButterworthMethod,
+	// but written into a fixed array rather than a heap-allocated ReferenceCountedArray.
+	CutCoefficients cutCoefficients;
+	cutCoefficients.fill({ 1.0, 0.0, 0.0, 1.0, 0.0, 0.0 });
+	
+	const auto numSections = getNumCutSections(slope);
+	const auto order = numSections * 2;
+	
+	for (int i = 0; i < numSections; ++i)
+	{
+		const auto quality = 1.0 / (2.0 * std::cos((2.0 * i + 1.0) * juce::MathConstants<double>::pi / (order * 2.0)));
+		
+		cutCoefficients[(size_t) i] = normalise(isHighPass ? juce::dsp::IIR::ArrayCoefficients<double>::makeHighPass(sampleRate, (double) frequency, quality)
+														   : juce::dsp::IIR::ArrayCoefficients<double>::makeLowPass(sampleRate, (double) frequency, quality));
+	}
+	
+	return cutCoefficients;
+}
+
+CutCoefficients makeLowCutFilter (const ChannelSettings& channelSettings, double sampleRate)
+{
+	return makeButterworthCascade(channelSettings.lowCutFreq, channelSettings.lowCutSlope, sampleRate, true);
+}
+
+CutCoefficients makeHighCutFilter (const ChannelSettings& channelSettings, double sampleRate)
+{
+	return makeButterworthCascade(channelSettings.highCutFreq, channelSettings.highCutSlope, sampleRate, false);
+}
+
+bool isNeutral (const ChannelSettings& channelSettings)
+{
+	for (const auto& band : channelSettings.bands)
+		if (band.enabled && (band.type == Band_Notch || band.gainInDecibels != 0.f))
+			return false;
+	
+	return channelSettings.lowCutFreq <= 20.f
+		&& channelSettings.highCutFreq >= 20000.f;
+}
+
+ChainCoefficients makeChainCoefficients (const ChannelSettings& channelSettings, double sampleRate)
+{
+	const Coefficients unity { 1.0, 0.0, 0.0, 1.0, 0.0, 0.0 };
+	
+	ChainCoefficients chainCoefficients;
+	
+	for (size_t i = 0; i < channelSettings.bands.size(); ++i)
+	{
+		const auto& band = channelSettings.bands[i];
+		chainCoefficients.bands[i] = band.enabled ? makeBandFilter(band, sampleRate) : unity;
+		chainCoefficients.enabledBands[i] = band.enabled;
+	}
+	
+	chainCoefficients.lowCut = makeLowCutFilter(channelSettings, sampleRate);
+	chainCoefficients.highCut = makeHighCutFilter(channelSettings, sampleRate);
+	chainCoefficients.lowCutSlope = channelSettings.lowCutSlope;
+	chainCoefficients.highCutSlope = channelSettings.highCutSlope;
+	chainCoefficients.sampleRate = sampleRate;
+	chainCoefficients.isNeutral = isNeutral(channelSettings);
+	
+	return chainCoefficients;
+}
+
+static Coefficients interpolate (const Coefficients& start, const Coefficients& end, float proportion)
+{
+	Coefficients coefficients;
+	
+	for (size_t i = 0; i < coefficients.size(); ++i)
+		coefficients[i] = start[i] + proportion * (end[i] - start[i]);
+	
+	return coefficients;
+}
+
+ChainCoefficients interpolateCoefficients (const ChainCoefficients& start, const ChainCoefficients& end, float proportion)
+{
+	jassert(start.lowCutSlope == end.lowCutSlope && start.highCutSlope == end.highCutSlope);
+	
+	ChainCoefficients chainCoefficients = end;
+	
+	for (size_t i = 0; i < chainCoefficients.bands.size(); ++i)
+	{
+		chainCoefficients.bands[i] = interpolate(start.bands[i], end.bands[i], proportion);
+		chainCoefficients.enabledBands[i] = start.enabledBands[i] || end.enabledBands[i];
+	}
+	
+	for (size_t i = 0; i < chainCoefficients.lowCut.size(); ++i)
+	{
+		chainCoefficients.lowCut[i] = interpolate(start.lowCut[i], end.lowCut[i], proportion);
+		chainCoefficients.highCut[i] = interpolate(start.highCut[i], end.highCut[i], proportion);
+	}
+	
+	return chainCoefficients;
+}
+
+static float interpolateLogarithmically (float start, float end, float proportion)
+{
+	return start * std::pow(end / start, proportion);
+}
+
+ChannelSettings interpolateSettings (const ChannelSettings& start, const ChannelSettings& end, float proportion)
+{
+	ChannelSettings channelSettings = end;
+	
+	for (size_t i = 0; i < channelSettings.bands.size(); ++i)
+	{
+		const auto& startBand = start.bands[i];
+		const auto& endBand = end.bands[i];
+		
+		if (startBand.type != endBand.type || startBand.enabled != endBand.enabled)
+			continue;
+		
+		auto& band = channelSettings.bands[i];
+		band.freq = interpolateLogarithmically(startBand.freq, endBand.freq, proportion);
+		band.quality = interpolateLogarithmically(startBand.quality, endBand.quality, proportion);
+		band.gainInDecibels = startBand.gainInDecibels + proportion * (endBand.gainInDecibels - startBand.gainInDecibels);
+	}
+	
+	channelSettings.lowCutFreq = interpolateLogarithmically(start.lowCutFreq, end.lowCutFreq, proportion);
+	channelSettings.highCutFreq = interpolateLogarithmically(start.highCutFreq, end.highCutFreq, proportion);
+	
+	return channelSettings;
+}
+
+ChainCoefficients makeUnityCoefficients (const ChainCoefficients& layout)
+{
+	const Coefficients unity { 1.0, 0.0, 0.0, 1.0, 0.0, 0.0 };
+	
+	ChainCoefficients chainCoefficients = layout;
+	chainCoefficients.bands.fill(unity);
+	chainCoefficients.lowCut.fill(unity);
+	chainCoefficients.highCut.fill(unity);
+	
+	return chainCoefficients;
+}
+
+bool haveDifferentLayouts (const ChannelSettings& first, const ChannelSettings& second)
+{
+	if (first.lowCutSlope != second.lowCutSlope || first.highCutSlope != second.highCutSlope)
+		return true;
+	
+	for (size_t i = 0; i < first.bands.size(); ++i)
+		if (first.bands[i].type != second.bands[i].type || first.bands[i].enabled != second.bands[i].enabled)
+			return true;
+	
+	return false;
+}
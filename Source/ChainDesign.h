@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+    ChainDesign.h
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BiquadCascade.h"
+
+enum Slope
+{
+	Slope_12,
+	Slope_24,
+	Slope_36,
+	Slope_48
+};
+
+enum BandType
+{
+	Band_Bell,
+	Band_LowShelf,
+	Band_HighShelf,
+	Band_Notch
+};
+
+// One parametric band. A disabled band takes no section in the cascade.
+struct BandSettings
+{
+	BandType type { Band_Bell };
+	float freq { 1000.f }, gainInDecibels { 0 }, quality { 1.f };
+	bool enabled { false };
+};
+
+constexpr int maxNumBands = 8;
+
+struct ChannelSettings
+{
+	std::array<BandSettings, maxNumBands> bands {};
+	float lowCutFreq { 0 }, highCutFreq { 0 };
+	Slope lowCutSlope { Slope::Slope_12 }, highCutSlope { Slope::Slope_12 };
+};
+
+// First section slot of each stage in the BiquadCascade: four low cut sections,
+// one per band, then four high cut sections.
+enum ChainPositions
+{
+	Lowcut = 0,
+	Bands = 4,
+	HighCut = Bands + maxNumBands
+};
+
+using CutCoefficients = std::array<Coefficients, 4>;
+
+// The RBJ cookbook biquad for the band's type.
+Coefficients makeBandFilter(const BandSettings& band, double sampleRate);
+
+// A bell band, matched in magnitude to its analog prototype rather than bilinear-transformed
+// (M. Vicanek, "Matched Second Order Digital Filters", 2016). Poles come from
+// the matched-z transform and the zeros are solved so the gain at DC, at the
+// centre frequency and the curvature there agree with the analog prototype,
+// which keeps the shape close to it right up to Nyquist.
+Coefficients makeMatchedPeakFilter(const BandSettings& band, double sampleRate);
+CutCoefficients makeLowCutFilter(const ChannelSettings& channelSettings, double sampleRate);
+CutCoefficients makeHighCutFilter(const ChannelSettings& channelSettings, double sampleRate);
+
+int getNumCutSections(Slope slope);
+
+// The magnitude of the analog prototypes the stages are designed from, free of
+// any bilinear warping; this is the curve the linear-phase kernel follows.
+void getAnalogMagnitudeResponse(const ChannelSettings& channelSettings, const double* frequencies, double* magnitudes, size_t numFrequencies);
+
+// Roughly how long the chain takes to ring down by 60 dB, set by its most
+// resonant, lowest-frequency section.
+double getRingingTimeSeconds(const ChannelSettings& channelSettings);
+
+// Multiplies each of the magnitudes by the gain of one section at the matching
+// frequency, so a whole stage can be evaluated over a frequency axis at once.
+void applyMagnitudeResponse(const Coefficients& coefficients, const double* frequencies, double* magnitudes, size_t numFrequencies, double sampleRate);
+
+// One complete design of the filter chain, handed from the design thread
+// to the audio thread as a unit.
+struct ChainCoefficients
+{
+	// Disabled bands hold unity coefficients, so gliding to or from one fades it.
+	std::array<Coefficients, maxNumBands> bands {};
+	std::array<bool, maxNumBands> enabledBands {};
+	CutCoefficients lowCut {}, highCut {};
+	Slope lowCutSlope { Slope::Slope_12 }, highCutSlope { Slope::Slope_12 };
+	double sampleRate { 0 };
+	
+	// Designed from neutral settings, so the chain can be bypassed outright.
+	bool isNeutral { false };
+};
+
+// Both cuts at the edges of the audio band, and every enabled band a flat bell
+// or shelf. What's left of the curve is below 20 Hz and above 20 kHz.
+bool isNeutral(const ChannelSettings& channelSettings);
+
+ChainCoefficients makeChainCoefficients(const ChannelSettings& channelSettings, double sampleRate);
+
+// Linear blend between two designs. Normalised biquads with the same section
+// layout stay stable along the way, since their stable (a1, a2) region is convex.
+// A band enabled at either end stays enabled throughout, gliding from or to unity.
+ChainCoefficients interpolateCoefficients(const ChainCoefficients& start, const ChainCoefficients& end, float proportion);
+
+// A move from one design to another, broken into designs for the parameter
+// values along the way, so a block can be split and swept through them. The
+// last step is the design the move ends on.
+struct DesignTrajectory
+{
+	static constexpr int maxNumSteps = 32;
+	
+	std::array<ChainCoefficients, maxNumSteps> steps {};
+	int numSteps { 1 };
+	
+	const ChainCoefficients& getFinal() const	{ return steps[(size_t) numSteps - 1]; }
+};
+
+// Settings part of the way from start to end: frequencies and Q move on a log
+// scale and gain in decibels, the way a host would draw the automation. Slopes,
+// band types and enabled bands can't move gradually, so they are taken from end,
+// as is a band whose type or enabled state differs.
+ChannelSettings interpolateSettings(const ChannelSettings& start, const ChannelSettings& end, float proportion);
+
+// The same layout with every section passing its input straight through, to
+// glide towards when a chain is about to be bypassed or away from when it resumes.
+ChainCoefficients makeUnityCoefficients(const ChainCoefficients& layout);
+
+// True if the two can't be swept between, one band at a time: a slope, band
+// type or enabled band differs.
+bool haveDifferentLayouts(const ChannelSettings& first, const ChannelSettings& second);
@@ -0,0 +1,154 @@
+/*
+  ==============================================================================
+
+    CoefficientCache.cpp
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#include "CoefficientCache.h"
+
+//==============================================================================
+// Parameter steps from createParameterLayout(). Designs are made from the
+// quantised values, so a hit returns exactly what a fresh design would.
+static constexpr float qualityStep = 0.05f, gainStep = 0.5f, minGainInDecibels = -36.f;
+
+size_t CoefficientCache::Key::getSlotIndex (size_t numSlots) const noexcept
+{
+	auto hash = (juce::uint32) sampleRate * 2654435761u;
+	hash ^= (juce::uint32) frequency * 2246822519u + (hash << 6) + (hash >> 2);
+	hash ^= (juce::uint32) shape * 3266489917u + (hash << 6) + (hash >> 2);
+	hash ^= (juce::uint32) kind * 668265263u + (hash << 6) + (hash >> 2);
+	
+	jassert(juce::isPowerOfTwo(numSlots));
+	return (size_t) hash & (numSlots - 1);
+}
+
+CoefficientCache::CoefficientCache()
+	: bandSlots(numSlotsPerTable), cutSlots(numSlotsPerTable)
+{
+}
+
+Coefficients CoefficientCache::getBandFilter (const BandSettings& band, double sampleRate)
+{
+	// A notch has no gain, so every gain shares one entry.
+	const auto qualityIndex = juce::roundToInt(band.quality / qualityStep);
+	const auto gainIndex = band.type != Band_Notch ? juce::roundToInt((band.gainInDecibels - minGainInDecibels) / gainStep) : 0;
+	
+	Key key;
+	key.sampleRate = juce::roundToInt(sampleRate);
+	key.frequency = juce::roundToInt(band.freq);
+	key.shape = ((int) band.type * 256 + qualityIndex) * 256 + gainIndex;
+	key.kind = Kind::band;
+	
+	const juce::ScopedLock sl(lock);
+	auto& slot = bandSlots[key.getSlotIndex(bandSlots.size())];
+	
+	if (slot.key == key)
+	{
+		++hits;
+		return slot.value;
+	}
+	
+	++misses;
+	
+	BandSettings quantised;
+	quantised.type = band.type;
+	quantised.freq = (float) key.frequency;
+	quantised.quality = (float) qualityIndex * qualityStep;
+	quantised.gainInDecibels = (float) gainIndex * gainStep + minGainInDecibels;
+	quantised.enabled = true;
+	
+	slot.key = key;
+	slot.value = ::makeBandFilter(quantised, sampleRate);
+	return slot.value;
+}
+
+CutCoefficients CoefficientCache::getLowCutFilter (const ChannelSettings& channelSettings, double sampleRate)
+{
+	return getCutFilter(Kind::lowCut, channelSettings.lowCutFreq, channelSettings.lowCutSlope, sampleRate);
+}
+
+CutCoefficients CoefficientCache::getHighCutFilter (const ChannelSettings& channelSettings, double sampleRate)
+{
+	return getCutFilter(Kind::highCut, channelSettings.highCutFreq, channelSettings.highCutSlope, sampleRate);
+}
+
+CutCoefficients CoefficientCache::getCutFilter (Kind kind, float frequency, Slope slope, double sampleRate)
+{
+	Key key;
+	key.sampleRate = juce::roundToInt(sampleRate);
+	key.frequency = juce::roundToInt(frequency);
+	key.shape = (int) slope;
+	key.kind = kind;
+	
+	const juce::ScopedLock sl(lock);
+	auto& slot = cutSlots[key.getSlotIndex(cutSlots.size())];
+	
+	if (slot.key == key)
+	{
+		++hits;
+		return slot.value;
+	}
+	
+	++misses;
+	
+	ChannelSettings quantised;
+	quantised.lowCutFreq = quantised.highCutFreq = (float) key.frequency;
+	quantised.lowCutSlope = quantised.highCutSlope = slope;
+	
+	slot.key = key;
+	slot.value = kind == Kind::lowCut ? ::makeLowCutFilter(quantised, sampleRate)
+									  : ::makeHighCutFilter(quantised, sampleRate);
+	return slot.value;
+}
+
+ChainCoefficients CoefficientCache::makeChainCoefficients (const ChannelSettings& channelSettings, double sampleRate)
+{
+	const Coefficients unity { 1.0, 0.0, 0.0, 1.0, 0.0, 0.0 };
+	
+	ChainCoefficients chainCoefficients;
+	
+	for (size_t i = 0; i < channelSettings.bands.size(); ++i)
+	{
+		const auto& band = channelSettings.bands[i];
+		chainCoefficients.bands[i] = band.enabled ? getBandFilter(band, sampleRate) : unity;
+		chainCoefficients.enabledBands[i] = band.enabled;
+	}
+	
+	chainCoefficients.lowCut = getLowCutFilter(channelSettings, sampleRate);
+	chainCoefficients.highCut = getHighCutFilter(channelSettings, sampleRate);
+	chainCoefficients.lowCutSlope = channelSettings.lowCutSlope;
+	chainCoefficients.highCutSlope = channelSettings.highCutSlope;
+	chainCoefficients.sampleRate = sampleRate;
+	chainCoefficients.isNeutral = isNeutral(channelSettings);
+	
+	return chainCoefficients;
+}
+
+CoefficientCache::Statistics CoefficientCache::getStatistics() const
+{
+	const juce::ScopedLock sl(lock);
+	
+	Statistics statistics;
+	statistics.hits = hits;
+	statistics.misses = misses;
+	statistics.numSlots = (int) (bandSlots.size() + cutSlots.size());
+	statistics.memoryFootprintInBytes = sizeof(*this) + bandSlots.size() * sizeof(bandSlots[0]) + cutSlots.size() * sizeof(cutSlots[0]);
+	
+	for (auto& slot : bandSlots)
+		statistics.numSlotsUsed += slot.key.kind != Kind::none ? 1 : 0;
+	
+	for (auto& slot : cutSlots)
+		statistics.numSlotsUsed += slot.key.kind != Kind::none ? 1 : 0;
+	
+	return statistics;
+}
+
+void CoefficientCache::resetStatistics()
+{
+	const juce::ScopedLock sl(lock);
+	hits = misses = 0;
+}
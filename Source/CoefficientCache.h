@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+    CoefficientCache.h
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ChainDesign.h"
+
+//==============================================================================
+/**
+    A process-wide cache of stage designs, keyed by sample rate and by the
+    parameter values quantised to the steps createParameterLayout() uses:
+    1 Hz for frequencies, 0.05 for Q, 0.5 dB for gain, one of four band types
+    and one of four slopes.
+
+    It's a fixed-size, direct-mapped table. Every key hashes to exactly one
+    slot and a miss overwrites whatever was there, so lookups never allocate
+    and the memory footprint is known up front: with two tables of 2048 slots
+    of double coefficients it's about 544 KB, and getStatistics() reports the
+    exact figure. It is meant to be held through a SharedResourcePointer and
+    used from the design thread and prepareToPlay(), never from the audio
+    thread.
+*/
+class CoefficientCache
+{
+public:
+	struct Statistics
+	{
+		juce::int64 hits { 0 }, misses { 0 };
+		int numSlotsUsed { 0 }, numSlots { 0 };
+		size_t memoryFootprintInBytes { 0 };
+		
+		double getHitRate() const noexcept
+		{
+			const auto lookups = hits + misses;
+			return lookups > 0 ? (double) hits / (double) lookups : 0.0;
+		}
+	};
+	
+	CoefficientCache();
+	
+	Coefficients getBandFilter (const BandSettings& band, double sampleRate);
+	CutCoefficients getLowCutFilter (const ChannelSettings& channelSettings, double sampleRate);
+	CutCoefficients getHighCutFilter (const ChannelSettings& channelSettings, double sampleRate);
+	
+	/** The cached equivalent of ::makeChainCoefficients(). */
+	ChainCoefficients makeChainCoefficients (const ChannelSettings& channelSettings, double sampleRate);
+	
+	Statistics getStatistics() const;
+	void resetStatistics();
+	
+private:
+	enum class Kind
+	{
+		none,
+		band,
+		lowCut,
+		highCut
+	};
+	
+	struct Key
+	{
+		int sampleRate { 0 }, frequency { 0 }, shape { 0 };
+		Kind kind { Kind::none };
+		
+		bool operator== (const Key& other) const noexcept
+		{
+			return sampleRate == other.sampleRate && frequency == other.frequency
+				&& shape == other.shape && kind == other.kind;
+		}
+		
+		size_t getSlotIndex (size_t numSlots) const noexcept;
+	};
+	
+	template <typename Value>
+	struct Slot
+	{
+		Key key;
+		Value value {};
+	};
+	
+	static constexpr size_t numSlotsPerTable = 2048;
+	
+	std::vector<Slot<Coefficients>> bandSlots;
+	std::vector<Slot<CutCoefficients>> cutSlots;
+	
+	juce::CriticalSection lock;
+	juce::int64 hits { 0 }, misses { 0 };
+	
+	CutCoefficients getCutFilter (Kind kind, float frequency, Slope slope, double sampleRate);
+	
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CoefficientCache)
+};
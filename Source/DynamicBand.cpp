@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+    DynamicBand.cpp
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#include "DynamicBand.h"
+
+//==============================================================================
+void DynamicBand::makeTable (const BandSettings& band, double newSampleRate, Table& table)
+{
+	auto reduced = band;
+	reduced.enabled = true;
+	
+	for (size_t step = 0; step < table.steps.size(); ++step)
+	{
+		reduced.gainInDecibels = band.gainInDecibels - (float) step * tableStepInDecibels;
+		table.steps[step] = makeBandFilter(reduced, newSampleRate);
+	}
+	
+	table.sampleRate = newSampleRate;
+}
+
+Coefficients DynamicBand::getCoefficients (const Table& table, float reductionInDecibels) noexcept
+{
+	const auto position = juce::jlimit(0.f, (float) (tableSize - 1), reductionInDecibels / tableStepInDecibels);
+	const auto index = juce::jmin((int) position, tableSize - 2);
+	const auto proportion = (double) (position - (float) index);
+	
+	const auto& lower = table.steps[(size_t) index];
+	const auto& upper = table.steps[(size_t) index + 1];
+	Coefficients result;
+	
+	for (size_t i = 0; i < result.size(); ++i)
+		result[i] = lower[i] + proportion * (upper[i] - lower[i]);
+	
+	return result;
+}
+
+void DynamicBand::prepare (double newSampleRate, int maxBlockSize)
+{
+	sampleRate = newSampleRate;
+	reductions.assign((size_t) ((maxBlockSize + controlInterval - 1) / controlInterval), 0.f);
+	reset();
+}
+
+void DynamicBand::reset() noexcept
+{
+	envelope = minLevelInDecibels;
+	std::fill(reductions.begin(), reductions.end(), 0.f);
+}
+
+template <typename SampleType>
+void DynamicBand::analyse (const juce::AudioBuffer<SampleType>& detector, int numSamples, const DynamicsSettings& settings) noexcept
+{
+	const auto numIntervals = (numSamples + controlInterval - 1) / controlInterval;
+	jassert(numIntervals <= (int) reductions.size());
+	
+	// One-pole smoothing per control interval rather than per sample.
+	const auto intervalSeconds = controlInterval / sampleRate;
+	const auto attack = (float) std::exp(-intervalSeconds / juce::jmax(1.0e-4, settings.attackInMilliseconds * 1.0e-3));
+	const auto release = (float) std::exp(-intervalSeconds / juce::jmax(1.0e-4, settings.releaseInMilliseconds * 1.0e-3));
+	const auto slope = 1.f - 1.f / juce::jmax(1.f, settings.ratio);
+	
+	for (int interval = 0; interval < juce::jmin(numIntervals, (int) reductions.size()); ++interval)
+	{
+		const auto start = interval * controlInterval;
+		const auto length = juce::jmin(controlInterval, numSamples - start);
+		SampleType peak = 0;
+		
+		for (int channel = 0; channel < detector.getNumChannels(); ++channel)
+			peak = juce::jmax(peak, detector.getMagnitude(channel, start, length));
+		
+		const auto level = juce::Decibels::gainToDecibels((float) peak, minLevelInDecibels);
+		envelope = level + (level > envelope ? attack : release) * (envelope - level);
+		
+		const auto over = envelope - settings.thresholdInDecibels;
+		reductions[(size_t) interval] = over > 0.f ? juce::jmin(maxReductionInDecibels, over * slope) : 0.f;
+	}
+}
+
+template void DynamicBand::analyse (const juce::AudioBuffer<float>&, int, const DynamicsSettings&) noexcept;
+template void DynamicBand::analyse (const juce::AudioBuffer<double>&, int, const DynamicsSettings&) noexcept;
@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    DynamicBand.h
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ChainDesign.h"
+
+// Where band one's gain reduction is keyed from, if anywhere.
+enum DynamicsMode
+{
+	Dynamics_Off,
+	Dynamics_Input,
+	Dynamics_Sidechain
+};
+
+struct DynamicsSettings
+{
+	float thresholdInDecibels { -24.f }, ratio { 2.f };
+	float attackInMilliseconds { 5.f }, releaseInMilliseconds { 100.f };
+};
+
+//==============================================================================
+/**
+    Turns band one into a dynamic band: its gain is cut further the louder the
+    detector signal gets over the threshold, by (level - threshold) * (1 - 1 / ratio),
+    up to maxReductionInDecibels.
+
+    Nothing is designed on the audio thread. The design thread fills a Table
+    with the band's coefficients at every tableStepInDecibels of reduction, and
+    the audio thread interpolates between two neighbouring entries, which stays
+    stable since both are normalised biquads of the same shape.
+
+    The envelope runs at control rate: once every controlInterval samples it
+    takes the peak of that stretch of the detector, found with JUCE's vectorised
+    min/max, and follows it in decibels with separate attack and release times.
+*/
+class DynamicBand
+{
+public:
+	static constexpr int controlInterval = 16;
+	static constexpr float maxReductionInDecibels = 24.f;
+	static constexpr float tableStepInDecibels = 0.5f;
+	static constexpr int tableSize = (int) (maxReductionInDecibels / tableStepInDecibels) + 1;
+	
+	struct Table
+	{
+		std::array<Coefficients, (size_t) tableSize> steps {};
+		double sampleRate { 0 };
+	};
+	
+	/** Designs the band at every step of reduction from its own gain downwards. */
+	static void makeTable (const BandSettings& band, double sampleRate, Table& table);
+	
+	static Coefficients getCoefficients (const Table& table, float reductionInDecibels) noexcept;
+	
+	/** Makes room for the reductions of the largest block. Not for the audio thread. */
+	void prepare (double sampleRate, int maxBlockSize);
+	void reset() noexcept;
+	
+	/** Works out the reduction for each control interval of the block, carrying
+		the envelope on from the last block. A detector with no channels counts
+		as silence.
+	*/
+	template <typename SampleType>
+	void analyse (const juce::AudioBuffer<SampleType>& detector, int numSamples, const DynamicsSettings& settings) noexcept;
+	
+	/** The reduction in decibels for the given control interval of the last
+		analysed block. Past the largest block prepared for, the last one holds.
+	*/
+	float getReduction (int interval) const noexcept		{ return reductions[(size_t) juce::jmin(interval, (int) reductions.size() - 1)]; }
+
+private:
+	static constexpr float minLevelInDecibels = -120.f;
+	
+	std::vector<float> reductions;
+	double sampleRate { 0 };
+	float envelope { minLevelInDecibels };
+	
+	JUCE_DECLARE_NON_COPYABLE (DynamicBand)
+};
@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    FilterDesignThread.cpp
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#include "FilterDesignThread.h"
+
+//==============================================================================
+FilterDesignThread::FilterDesignThread()
+	: juce::Thread("AwesomeEQ Filter Design")
+{
+	startThread();
+}
+
+FilterDesignThread::~FilterDesignThread()
+{
+	stopThread(1000);
+}
+
+void FilterDesignThread::addClient (Client* client)
+{
+	const juce::ScopedLock sl(clientLock);
+	clients.addIfNotAlreadyThere(client);
+}
+
+void FilterDesignThread::removeClient (Client* client)
+{
+	const juce::ScopedLock sl(clientLock);
+	clients.removeFirstMatchingValue(client);
+}
+
+void FilterDesignThread::run()
+{
+	while (! threadShouldExit())
+	{
+		if (! designRequested.exchange(false, std::memory_order_acquire))
+		{
+			wait(pollIntervalMilliseconds);
+			continue;
+		}
+		
+		const juce::ScopedLock sl(clientLock);
+		
+		for (auto* client : clients)
+			client->designFilters();
+	}
+}
@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+    FilterDesignThread.h
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    A background thread that runs filter design away from the audio callback.
+
+    It is meant to be held through a juce::SharedResourcePointer, so every
+    plugin instance in the process shares the one thread. Clients flag their
+    own pending work and call requestDesign(); the thread then gives every
+    registered client a chance to design and publish new coefficients.
+*/
+class FilterDesignThread  : private juce::Thread
+{
+public:
+	struct Client
+	{
+		virtual ~Client() = default;
+		
+		/** Called on the design thread. Should return quickly if nothing changed. */
+		virtual void designFilters() = 0;
+	};
+	
+	FilterDesignThread();
+	~FilterDesignThread() override;
+	
+	/** Registers a client. Once removeClient() returns, the client is guaranteed
+		not to be inside designFilters() any more.
+	*/
+	void addClient (Client* client);
+	void removeClient (Client* client);
+	
+	/** Asks the design thread for a pass over every client. It only sets a
+		flag, which the thread polls, so it never waits on a lock and is safe
+		to call from the audio thread.
+	*/
+	void requestDesign() noexcept					{ designRequested.store(true, std::memory_order_release); }
+	
+private:
+	// How long a request can go unnoticed. notify() would wake the thread
+	// straight away, but it takes the WaitableEvent's mutex.
+	static constexpr int pollIntervalMilliseconds = 2;
+	
+	std::atomic<bool> designRequested { false };
+	
+	void run() override;
+	
+	juce::CriticalSection clientLock;
+	juce::Array<Client*> clients;
+	
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FilterDesignThread)
+};
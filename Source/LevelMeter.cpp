@@ -0,0 +1,376 @@
+/*
+  ==============================================================================
+
+    LevelMeter.cpp
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#include "LevelMeter.h"
+
+//==============================================================================
+LevelMeter::LevelMeter()
+{
+	reset();
+}
+
+void LevelMeter::makeBandFilters (const ChannelSettings& channelSettings, double newSampleRate, BandFilters& result)
+{
+	using ArrayCoefficients = juce::dsp::IIR::ArrayCoefficients<double>;
+	
+	for (size_t i = 0; i < channelSettings.bands.size(); ++i)
+	{
+		const auto& band = channelSettings.bands[i];
+		result.enabledBands[i] = band.enabled;
+		
+		if (! band.enabled)
+		{
+			result.bands[i] = { 1.0, 0.0, 0.0, 1.0, 0.0, 0.0 };
+			continue;
+		}
+		
+		const auto frequency = juce::jlimit(10.0, 0.45 * newSampleRate, (double) band.freq);
+		
+		switch (band.type)
+		{
+			case Band_LowShelf:		result.bands[i] = ArrayCoefficients::makeLowPass(newSampleRate, frequency); break;
+			case Band_HighShelf:	result.bands[i] = ArrayCoefficients::makeHighPass(newSampleRate, frequency); break;
+			case Band_Bell:
+			case Band_Notch:
+			default:				result.bands[i] = ArrayCoefficients::makeBandPass(newSampleRate, frequency, (double) band.quality); break;
+		}
+		
+		const auto a0Inverse = 1.0 / result.bands[i][3];
+		
+		for (auto& coefficient : result.bands[i])
+			coefficient *= a0Inverse;
+	}
+	
+	result.sampleRate = newSampleRate;
+}
+
+//==============================================================================
+void LevelMeter::prepare (double newSampleRate, int numChannels, int newMaxBlockSize)
+{
+	// A windowed sinc at the original Nyquist frequency, centred between two
+	// taps, so the four phases land at 1/8, 3/8, 5/8 and 7/8 of a sample.
+	const auto centre = 0.5 * (numTaps - 1);
+	
+	for (int phase = 0; phase < oversamplingFactor; ++phase)
+	{
+		auto& taps = phases[(size_t) phase];
+		float sum = 0.f;
+		
+		for (int k = 0; k < tapsPerPhase; ++k)
+		{
+			// Tap k of a phase meets the sample tapsPerPhase - 1 - k back from the newest.
+			const auto n = phase + oversamplingFactor * (tapsPerPhase - 1 - k);
+			const auto x = (n - centre) / oversamplingFactor;
+			const auto sinc = x == 0.0 ? 1.0 : std::sin(juce::MathConstants<double>::pi * x) / (juce::MathConstants<double>::pi * x);
+			const auto position = juce::MathConstants<double>::twoPi * (n + 0.5) / numTaps;
+			const auto window = 0.42 - 0.5 * std::cos(position) + 0.08 * std::cos(2.0 * position);
+			
+			taps[(size_t) k] = (float) (sinc * window);
+			sum += taps[(size_t) k];
+		}
+		
+		// Unity gain at DC for every phase, so a constant reads the same between samples.
+		for (auto& tap : taps)
+			tap /= sum;
+	}
+	
+	sampleRate = newSampleRate;
+	maxBlockSize = juce::jmax(1, newMaxBlockSize);
+	
+	for (auto* detector : { &inputDetector, &outputDetector })
+		detector->history.assign((size_t) numChannels, std::vector<float> ((size_t) (tapsPerPhase - 1 + maxBlockSize)));
+	
+	interpolated.assign((size_t) maxBlockSize, 0.f);
+	mono.assign((size_t) maxBlockSize, 0.f);
+	
+	// Filters designed for this rate can stay; any others wait for the design thread.
+	if (bandFilters.sampleRate != sampleRate)
+		bandFilters = {};
+	
+	reset();
+}
+
+void LevelMeter::reset() noexcept
+{
+	for (auto* detector : { &inputDetector, &outputDetector })
+	{
+		for (auto& channel : detector->history)
+			std::fill(channel.begin(), channel.end(), 0.f);
+		
+		detector->momentaryMeanSquare = detector->sumOfSquares = 0.0;
+		detector->truePeak = 0.f;
+	}
+	
+	numInputSamples = numOutputSamples = 0;
+	
+	for (auto& state : bandStates)
+		state.fill(0.0);
+	
+	bandMomentaryMeanSquares.fill(0.0);
+	bandSumsOfSquares.fill(0.0);
+	bandNumSamples.fill(0);
+	
+	for (auto* published : { &publishedInput, &publishedOutput })
+		published->rms = published->integratedRms = published->truePeak = minLevelInDecibels;
+	
+	for (size_t i = 0; i < publishedBandEnergy.size(); ++i)
+	{
+		publishedBandEnergy[i] = publishedIntegratedBandEnergy[i] = minLevelInDecibels;
+		publishedMeasuredBands[i] = bandFilters.enabledBands[i];
+	}
+	
+	publishedNumSamples = 0;
+}
+
+void LevelMeter::setBandFilters (const BandFilters& newBandFilters) noexcept
+{
+	if (newBandFilters.sampleRate != sampleRate)
+		return;
+	
+	for (size_t i = 0; i < bandFilters.bands.size(); ++i)
+	{
+		if (newBandFilters.enabledBands[i] == bandFilters.enabledBands[i] && newBandFilters.bands[i] == bandFilters.bands[i])
+			continue;
+		
+		bandStates[i].fill(0.0);
+		bandMomentaryMeanSquares[i] = bandSumsOfSquares[i] = 0.0;
+		bandNumSamples[i] = 0;
+		
+		publishedBandEnergy[i].store(minLevelInDecibels, std::memory_order_relaxed);
+		publishedIntegratedBandEnergy[i].store(minLevelInDecibels, std::memory_order_relaxed);
+		publishedMeasuredBands[i].store(newBandFilters.enabledBands[i], std::memory_order_relaxed);
+	}
+	
+	bandFilters = newBandFilters;
+}
+
+//==============================================================================
+template <typename SampleType>
+void LevelMeter::measureInput (const juce::AudioBuffer<SampleType>& buffer, int numSamples) noexcept
+{
+	if (resetRequested.exchange(false))
+		reset();
+	
+	measure(inputDetector, publishedInput, numInputSamples, buffer, numSamples, true);
+	publishedNumSamples.store(numInputSamples, std::memory_order_relaxed);
+}
+
+template <typename SampleType>
+void LevelMeter::measureOutput (const juce::AudioBuffer<SampleType>& buffer, int numSamples) noexcept
+{
+	measure(outputDetector, publishedOutput, numOutputSamples, buffer, numSamples, false);
+}
+
+template <typename SampleType>
+void LevelMeter::measure (Detector& detector, PublishedLevels& published, juce::int64& numSamplesMeasured,
+						  const juce::AudioBuffer<SampleType>& buffer, int numSamples, bool measureBands) noexcept
+{
+	const auto numChannels = juce::jmin(buffer.getNumChannels(), (int) detector.history.size());
+	
+	if (numChannels == 0 || numSamples <= 0)
+		return;
+	
+	// The channels are only mixed down for the bands, and only if one is enabled.
+	const auto& enabledBands = bandFilters.enabledBands;
+	const bool mixDown = measureBands && std::find(enabledBands.begin(), enabledBands.end(), true) != enabledBands.end();
+	
+	// Hosts may send more than they promised; anything longer goes in pieces.
+	for (int start = 0; start < numSamples; start += maxBlockSize)
+	{
+		const auto length = juce::jmin(maxBlockSize, numSamples - start);
+		double sumOfSquares = 0.0;
+		
+		if (mixDown)
+			juce::FloatVectorOperations::clear(mono.data(), length);
+		
+		for (int channel = 0; channel < numChannels; ++channel)
+		{
+			auto& history = detector.history[(size_t) channel];
+			auto* samples = history.data() + tapsPerPhase - 1;
+			const auto* source = buffer.getReadPointer(channel, start);
+			
+			for (int i = 0; i < length; ++i)
+			{
+				samples[i] = (float) source[i];
+				sumOfSquares += (double) source[i] * (double) source[i];
+			}
+			
+			if (mixDown)
+				juce::FloatVectorOperations::add(mono.data(), samples, length);
+			
+			detector.truePeak = juce::jmax(detector.truePeak, getTruePeak(history.data(), length));
+			
+			// Keep the newest samples in front for the next block's interpolation.
+			std::copy(history.begin() + length, history.begin() + length + tapsPerPhase - 1, history.begin());
+		}
+		
+		// The power averaged over the channels, so a duplicated mono signal reads as the mono one.
+		sumOfSquares /= numChannels;
+		// The first block after a reset stands for the whole window, rather than fading in from silence.
+		const auto weight = numSamplesMeasured == 0 ? 1.0 : getMomentaryWeight(length);
+		detector.momentaryMeanSquare += weight * (sumOfSquares / length - detector.momentaryMeanSquare);
+		detector.sumOfSquares += sumOfSquares;
+		numSamplesMeasured += length;
+		
+		if (mixDown)
+		{
+			juce::FloatVectorOperations::multiply(mono.data(), 1.f / (float) numChannels, length);
+			measureBandEnergy(length);
+		}
+	}
+	
+	published.rms.store(toDecibels(detector.momentaryMeanSquare), std::memory_order_relaxed);
+	published.integratedRms.store(toDecibels(detector.sumOfSquares / (double) numSamplesMeasured), std::memory_order_relaxed);
+	published.truePeak.store(juce::Decibels::gainToDecibels(detector.truePeak, minLevelInDecibels), std::memory_order_relaxed);
+	
+	if (! mixDown)
+		return;
+	
+	for (size_t i = 0; i < bandFilters.bands.size(); ++i)
+	{
+		if (! bandFilters.enabledBands[i])
+			continue;
+		
+		publishedBandEnergy[i].store(toDecibels(bandMomentaryMeanSquares[i]), std::memory_order_relaxed);
+		publishedIntegratedBandEnergy[i].store(toDecibels(bandSumsOfSquares[i] / (double) juce::jmax((juce::int64) 1, bandNumSamples[i])), std::memory_order_relaxed);
+	}
+}
+
+template void LevelMeter::measureInput (const juce::AudioBuffer<float>&, int) noexcept;
+template void LevelMeter::measureInput (const juce::AudioBuffer<double>&, int) noexcept;
+template void LevelMeter::measureOutput (const juce::AudioBuffer<float>&, int) noexcept;
+template void LevelMeter::measureOutput (const juce::AudioBuffer<double>&, int) noexcept;
+
+float LevelMeter::getTruePeak (const float* history, int numSamples) noexcept
+{
+	// The original samples count too, so the true peak is never below the sample peak.
+	const auto* samples = history + tapsPerPhase - 1;
+	auto range = juce::FloatVectorOperations::findMinAndMax(samples, numSamples);
+	auto peak = juce::jmax(-range.getStart(), range.getEnd());
+	
+	// One phase at a time across the whole block, so each pass is a plain vector multiply-add.
+	for (const auto& taps : phases)
+	{
+		juce::FloatVectorOperations::multiply(interpolated.data(), history, taps[0], numSamples);
+		
+		for (int k = 1; k < tapsPerPhase; ++k)
+			juce::FloatVectorOperations::addWithMultiply(interpolated.data(), history + k, taps[(size_t) k], numSamples);
+		
+		range = juce::FloatVectorOperations::findMinAndMax(interpolated.data(), numSamples);
+		peak = juce::jmax(peak, -range.getStart(), range.getEnd());
+	}
+	
+	return peak;
+}
+
+void LevelMeter::measureBandEnergy (int numSamples) noexcept
+{
+	const auto weight = getMomentaryWeight(numSamples);
+	
+	for (size_t band = 0; band < bandFilters.bands.size(); ++band)
+	{
+		if (! bandFilters.enabledBands[band])
+			continue;
+		
+		// The same transposed direct form II as BiquadCascade, on the one mono signal.
+		const auto& c = bandFilters.bands[band];
+		auto s1 = bandStates[band][0], s2 = bandStates[band][1];
+		double sumOfSquares = 0.0;
+		
+		for (int i = 0; i < numSamples; ++i)
+		{
+			const auto x = (double) mono[(size_t) i];
+			const auto y = c[0] * x + s1;
+			s1 = c[1] * x - c[4] * y + s2;
+			s2 = c[2] * x - c[5] * y;
+			sumOfSquares += y * y;
+		}
+		
+		// Flushed by hand, since the states are kept between blocks.
+		bandStates[band][0] = std::abs(s1) < 1.0e-15 ? 0.0 : s1;
+		bandStates[band][1] = std::abs(s2) < 1.0e-15 ? 0.0 : s2;
+		
+		const auto bandWeight = bandNumSamples[band] == 0 ? 1.0 : weight;
+		bandMomentaryMeanSquares[band] += bandWeight * (sumOfSquares / numSamples - bandMomentaryMeanSquares[band]);
+		bandSumsOfSquares[band] += sumOfSquares;
+		bandNumSamples[band] += numSamples;
+	}
+}
+
+double LevelMeter::getMomentaryWeight (int numSamples) const noexcept
+{
+	return 1.0 - std::exp(-numSamples / (momentarySeconds * sampleRate));
+}
+
+float LevelMeter::toDecibels (double meanSquare) noexcept
+{
+	return juce::Decibels::gainToDecibels((float) std::sqrt(meanSquare), minLevelInDecibels);
+}
+
+//==============================================================================
+LevelMeter::Readings LevelMeter::getReadings() const noexcept
+{
+	auto load = [] (const PublishedLevels& published)
+	{
+		Levels levels;
+		levels.rms = published.rms.load(std::memory_order_relaxed);
+		levels.integratedRms = published.integratedRms.load(std::memory_order_relaxed);
+		levels.truePeak = published.truePeak.load(std::memory_order_relaxed);
+		return levels;
+	};
+	
+	Readings readings;
+	readings.input = load(publishedInput);
+	readings.output = load(publishedOutput);
+	
+	for (size_t i = 0; i < readings.bandEnergy.size(); ++i)
+	{
+		readings.bandEnergy[i] = publishedBandEnergy[i].load(std::memory_order_relaxed);
+		readings.integratedBandEnergy[i] = publishedIntegratedBandEnergy[i].load(std::memory_order_relaxed);
+		readings.measuredBands[i] = publishedMeasuredBands[i].load(std::memory_order_relaxed);
+	}
+	
+	readings.numSamples = publishedNumSamples.load(std::memory_order_relaxed);
+	return readings;
+}
+
+juce::var LevelMeter::Readings::toVar() const
+{
+	auto levelsToVar = [] (const Levels& levels)
+	{
+		auto* object = new juce::DynamicObject();
+		object->setProperty("rms", levels.rms);
+		object->setProperty("integratedRms", levels.integratedRms);
+		object->setProperty("truePeak", levels.truePeak);
+		return juce::var(object);
+	};
+	
+	juce::Array<juce::var> bands;
+	
+	for (size_t i = 0; i < bandEnergy.size(); ++i)
+	{
+		if (! measuredBands[i])
+			continue;
+		
+		auto* entry = new juce::DynamicObject();
+		entry->setProperty("band", (int) i + 1);
+		entry->setProperty("energy", bandEnergy[i]);
+		entry->setProperty("integratedEnergy", integratedBandEnergy[i]);
+		bands.add(entry);
+	}
+	
+	auto* result = new juce::DynamicObject();
+	result->setProperty("samples", numSamples);
+	result->setProperty("input", levelsToVar(input));
+	result->setProperty("output", levelsToVar(output));
+	result->setProperty("bands", bands);
+	
+	return result;
+}
@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+    LevelMeter.h
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ChainDesign.h"
+
+//==============================================================================
+/**
+    Loudness and peak readings taken from the blocks processBlock() is already
+    working on: the RMS and true peak of the input and of the output, and the
+    energy of the input in the region each enabled band covers.
+
+    The true peak follows ITU-R BS.1770: every channel is interpolated to four
+    times the rate by a 48-tap polyphase FIR, and the largest magnitude of
+    the interpolated and the original samples is the peak.
+
+    Band energy is measured on the average of the channels, through a bandpass
+    at each bell or notch band's frequency and Q, and a low or high pass at each
+    shelf's corner frequency. Those filters are designed on the design thread
+    and handed over as BandFilters.
+
+    Each reading comes as a momentary value, weighted towards roughly the last
+    400 ms, and as an integrated one since the last reset; peaks are the largest
+    since the last reset. The audio thread is the only writer, publishing relaxed
+    atomics once per block, so getReadings() can be called from any thread. Its
+    fields are each consistent, though one may be a block ahead of another.
+*/
+class LevelMeter
+{
+public:
+	static constexpr int oversamplingFactor = 4;
+	static constexpr int tapsPerPhase = 12;
+	
+	// Anything quieter reads as this, rather than minus infinity.
+	static constexpr float minLevelInDecibels = -120.f;
+	
+	struct BandFilters
+	{
+		std::array<Coefficients, maxNumBands> bands {};
+		std::array<bool, maxNumBands> enabledBands {};
+		double sampleRate { 0 };
+	};
+	
+	LevelMeter();
+	
+	/** The filters that isolate each enabled band's region, at the host rate. */
+	static void makeBandFilters (const ChannelSettings& channelSettings, double sampleRate, BandFilters& bandFilters);
+	
+	struct Levels
+	{
+		float rms { minLevelInDecibels }, integratedRms { minLevelInDecibels }, truePeak { minLevelInDecibels };
+	};
+	
+	struct Readings
+	{
+		Levels input, output;
+		std::array<float, maxNumBands> bandEnergy {}, integratedBandEnergy {};
+		std::array<bool, maxNumBands> measuredBands {};
+		juce::int64 numSamples { 0 };
+		
+		juce::var toVar() const;
+	};
+	
+	/** Allocates the interpolator history and scratch space. Not for the audio thread. */
+	void prepare (double sampleRate, int numChannels, int maxBlockSize);
+	
+	/** Audio thread: starts every reading again. */
+	void reset() noexcept;
+	
+	/** Any thread: asks the audio thread to reset before it measures the next block. */
+	void requestReset() noexcept							{ resetRequested = true; }
+	
+	/** Audio thread: takes over a new set of band filters. Bands that moved
+		start their readings again; a set for another sample rate is ignored.
+	*/
+	void setBandFilters (const BandFilters& newBandFilters) noexcept;
+	
+	/** Audio thread: measures the block on its way into, or out of, the chain. */
+	template <typename SampleType>
+	void measureInput (const juce::AudioBuffer<SampleType>& buffer, int numSamples) noexcept;
+	
+	template <typename SampleType>
+	void measureOutput (const juce::AudioBuffer<SampleType>& buffer, int numSamples) noexcept;
+	
+	Readings getReadings() const noexcept;
+
+private:
+	static constexpr double momentarySeconds = 0.4;
+	static constexpr int numTaps = oversamplingFactor * tapsPerPhase;
+	
+	// What the audio thread keeps for one side, input or output.
+	struct Detector
+	{
+		// The last tapsPerPhase - 1 samples of the previous block, then the current one.
+		std::vector<std::vector<float>> history;
+		double momentaryMeanSquare { 0 }, sumOfSquares { 0 };
+		float truePeak { 0 };
+	};
+	
+	// What the other threads see of one side, in decibels.
+	struct PublishedLevels
+	{
+		std::atomic<float> rms { minLevelInDecibels }, integratedRms { minLevelInDecibels }, truePeak { minLevelInDecibels };
+	};
+	
+	std::array<std::array<float, (size_t) tapsPerPhase>, (size_t) oversamplingFactor> phases {};
+	std::vector<float> interpolated, mono;
+	double sampleRate { 0 };
+	int maxBlockSize { 0 };
+	
+	Detector inputDetector, outputDetector;
+	juce::int64 numInputSamples { 0 }, numOutputSamples { 0 };
+	
+	BandFilters bandFilters;
+	std::array<std::array<double, 2>, maxNumBands> bandStates {};
+	std::array<double, maxNumBands> bandMomentaryMeanSquares {}, bandSumsOfSquares {};
+	std::array<juce::int64, maxNumBands> bandNumSamples {};
+	
+	PublishedLevels publishedInput, publishedOutput;
+	std::array<std::atomic<float>, maxNumBands> publishedBandEnergy, publishedIntegratedBandEnergy;
+	std::array<std::atomic<bool>, maxNumBands> publishedMeasuredBands;
+	std::atomic<juce::int64> publishedNumSamples { 0 };
+	std::atomic<bool> resetRequested { false };
+	
+	template <typename SampleType>
+	void measure (Detector& detector, PublishedLevels& published, juce::int64& numSamplesMeasured, const juce::AudioBuffer<SampleType>& buffer, int numSamples, bool measureBands) noexcept;
+	
+	float getTruePeak (const float* history, int numSamples) noexcept;
+	void measureBandEnergy (int numSamples) noexcept;
+	
+	double getMomentaryWeight (int numSamples) const noexcept;
+	static float toDecibels (double meanSquare) noexcept;
+	
+	JUCE_DECLARE_NON_COPYABLE (LevelMeter)
+};
@@ -0,0 +1,218 @@
+/*
+  ==============================================================================
+
+    LinearPhaseConvolver.cpp
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#include "LinearPhaseConvolver.h"
+
+//==============================================================================
+void LinearPhaseKernelDesigner::design (const ChannelSettings& channelSettings, double sampleRate, int length, LinearPhaseKernel& kernel)
+{
+	jassert(juce::isPowerOfTwo(length) && length >= LinearPhaseConvolver::partitionSize && length <= LinearPhaseConvolver::maxKernelLength);
+	
+	const auto numKernelBins = (size_t) length / 2 + 1;
+	
+	if (kernelFFT == nullptr || kernelFFT->getSize() != length)
+	{
+		kernelFFT = std::make_unique<juce::dsp::FFT>(juce::roundToInt(std::log2((double) length)));
+		kernelBuffer.resize((size_t) length * 2);
+		frequencies.resize(numKernelBins);
+		magnitudes.resize(numKernelBins);
+	}
+	
+	if (partitionFFT == nullptr)
+	{
+		partitionFFT = std::make_unique<juce::dsp::FFT>(LinearPhaseConvolver::fftOrder);
+		partitionBuffer.resize((size_t) LinearPhaseConvolver::fftSize * 2);
+	}
+	
+	for (size_t bin = 0; bin < numKernelBins; ++bin)
+		frequencies[bin] = (double) bin * sampleRate / (double) length;
+	
+	getAnalogMagnitudeResponse(channelSettings, frequencies.data(), magnitudes.data(), numKernelBins);
+	
+	// A delay of length / 2 samples is a phase of -pi * bin, i.e. alternating
+	// signs, which leaves a kernel symmetric about its centre.
+	std::fill(kernelBuffer.begin(), kernelBuffer.end(), 0.f);
+	auto* bins = reinterpret_cast<std::complex<float>*>(kernelBuffer.data());
+	
+	for (size_t bin = 0; bin < numKernelBins; ++bin)
+		bins[bin] = (float) ((bin & 1) != 0 ? -magnitudes[bin] : magnitudes[bin]);
+	
+	kernelFFT->performRealOnlyInverseTransform(kernelBuffer.data());
+	
+	// Blackman window centred on the delay, to keep the truncation ripple down.
+	for (int n = 0; n < length; ++n)
+	{
+		const auto phase = juce::MathConstants<double>::twoPi * n / length;
+		kernelBuffer[(size_t) n] *= (float) (0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase));
+	}
+	
+	kernel.length = length;
+	kernel.numPartitions = length / LinearPhaseConvolver::partitionSize;
+	kernel.sampleRate = sampleRate;
+	kernel.partitions.resize((size_t) (kernel.numPartitions * LinearPhaseConvolver::numBins));
+	
+	for (int partition = 0; partition < kernel.numPartitions; ++partition)
+	{
+		std::fill(partitionBuffer.begin(), partitionBuffer.end(), 0.f);
+		std::copy_n(kernelBuffer.data() + partition * LinearPhaseConvolver::partitionSize, LinearPhaseConvolver::partitionSize, partitionBuffer.data());
+		
+		partitionFFT->performRealOnlyForwardTransform(partitionBuffer.data(), true);
+		
+		std::copy_n(reinterpret_cast<const std::complex<float>*>(partitionBuffer.data()), LinearPhaseConvolver::numBins,
+					kernel.partitions.data() + partition * LinearPhaseConvolver::numBins);
+	}
+}
+
+//==============================================================================
+void LinearPhaseConvolver::prepare (int numChannels)
+{
+	if (fft == nullptr)
+		fft = std::make_unique<juce::dsp::FFT>(fftOrder);
+	
+	channels.resize((size_t) numChannels);
+	
+	for (auto& state : channels)
+	{
+		state.inputWindow.resize(fftSize);
+		state.output.resize(partitionSize);
+		state.delayLine.resize(maxNumPartitions * numBins);
+	}
+	
+	fftBuffer.resize(fftSize * 2);
+	previousOutput.resize(partitionSize);
+	
+	reset();
+}
+
+void LinearPhaseConvolver::reset()
+{
+	for (auto& state : channels)
+	{
+		std::fill(state.inputWindow.begin(), state.inputWindow.end(), 0.f);
+		std::fill(state.output.begin(), state.output.end(), 0.f);
+		std::fill(state.delayLine.begin(), state.delayLine.end(), std::complex<float>());
+	}
+	
+	position = 0;
+	delayLineHead = 0;
+}
+
+void LinearPhaseConvolver::setKernel (const LinearPhaseKernel& kernel)
+{
+	initialKernel = kernel;
+	currentKernel = &initialKernel;
+}
+
+template <typename SampleType>
+void LinearPhaseConvolver::process (const juce::dsp::AudioBlock<SampleType>& block, double sampleRate) noexcept
+{
+	const auto numChannels = juce::jmin(block.getNumChannels(), channels.size());
+	const auto numSamples = block.getNumSamples();
+	
+	// Samples go in and out one partition behind, with a transform each time a partition fills up.
+	for (size_t start = 0; start < numSamples;)
+	{
+		const auto length = juce::jmin(numSamples - start, (size_t) (partitionSize - position));
+		
+		for (size_t channel = 0; channel < numChannels; ++channel)
+		{
+			auto* data = block.getChannelPointer(channel) + start;
+			auto& state = channels[channel];
+			
+			std::copy_n(data, length, state.inputWindow.data() + partitionSize + position);
+			std::copy_n(state.output.data() + position, length, data);
+		}
+		
+		position += (int) length;
+		start += length;
+		
+		if (position == partitionSize)
+		{
+			processPartition(sampleRate);
+			position = 0;
+		}
+	}
+}
+
+template void LinearPhaseConvolver::process (const juce::dsp::AudioBlock<float>&, double) noexcept;
+template void LinearPhaseConvolver::process (const juce::dsp::AudioBlock<double>&, double) noexcept;
+
+void LinearPhaseConvolver::processPartition (double sampleRate) noexcept
+{
+	delayLineHead = (delayLineHead + 1) % maxNumPartitions;
+	
+	for (auto& state : channels)
+	{
+		std::fill(fftBuffer.begin(), fftBuffer.end(), 0.f);
+		std::copy(state.inputWindow.begin(), state.inputWindow.end(), fftBuffer.begin());
+		fft->performRealOnlyForwardTransform(fftBuffer.data(), true);
+		
+		std::copy_n(reinterpret_cast<const std::complex<float>*>(fftBuffer.data()), numBins, state.delayLine.data() + delayLineHead * numBins);
+		
+		// Overlap-save: the newest partition becomes the older half of the next window.
+		std::copy(state.inputWindow.begin() + partitionSize, state.inputWindow.end(), state.inputWindow.begin());
+		
+		convolve(state, *currentKernel, state.output.data());
+	}
+	
+	// Everything that reads the outgoing kernel is done, so it's safe to let the
+	// design thread have its slot back.
+	if (! kernels.pull())
+		return;
+	
+	const auto& nextKernel = kernels.read();
+	
+	if (nextKernel.sampleRate != sampleRate)
+	{
+		// Stale kernels only turn up straight after prepare(), while the current
+		// one is still the kernel it was handed directly.
+		jassert(currentKernel == &initialKernel);
+		return;
+	}
+	
+	for (auto& state : channels)
+	{
+		std::copy(state.output.begin(), state.output.end(), previousOutput.begin());
+		convolve(state, nextKernel, state.output.data());
+		
+		for (int i = 0; i < partitionSize; ++i)
+		{
+			const auto proportion = (float) (i + 1) / (float) partitionSize;
+			state.output[(size_t) i] = previousOutput[(size_t) i] + proportion * (state.output[(size_t) i] - previousOutput[(size_t) i]);
+		}
+	}
+	
+	currentKernel = &nextKernel;
+}
+
+void LinearPhaseConvolver::convolve (const ChannelState& state, const LinearPhaseKernel& kernel, float* output) noexcept
+{
+	std::fill(fftBuffer.begin(), fftBuffer.end(), 0.f);
+	auto* accumulator = reinterpret_cast<std::complex<float>*>(fftBuffer.data());
+	
+	for (int partition = 0; partition < kernel.numPartitions; ++partition)
+	{
+		const auto index = (delayLineHead - partition + maxNumPartitions) % maxNumPartitions;
+		const auto* input = state.delayLine.data() + index * numBins;
+		const auto* coefficients = kernel.partitions.data() + partition * numBins;
+		
+		// Written out rather than with std::complex's operator*, which carries
+		// NaN/infinity recovery that stops it vectorising.
+		for (int bin = 0; bin < numBins; ++bin)
+		{
+			const auto x = input[bin], h = coefficients[bin];
+			accumulator[bin] += std::complex<float>(x.real() * h.real() - x.imag() * h.imag(),
+													x.real() * h.imag() + x.imag() * h.real());
+		}
+	}
+	
+	fft->performRealOnlyInverseTransform(fftBuffer.data());
+	std::copy_n(fftBuffer.data() + partitionSize, partitionSize, output);
+}
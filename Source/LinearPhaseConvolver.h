@@ -0,0 +1,121 @@
+/*
+  ==============================================================================
+
+    LinearPhaseConvolver.h
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ChainDesign.h"
+#include "TripleBuffer.h"
+
+//==============================================================================
+/**
+    A linear-phase FIR kernel, already split into the frequency-domain
+    partitions LinearPhaseConvolver multiplies with.
+*/
+struct LinearPhaseKernel
+{
+	std::vector<std::complex<float>> partitions;
+	int length { 0 }, numPartitions { 0 };
+	double sampleRate { 0 };
+};
+
+//==============================================================================
+/**
+    Builds a LinearPhaseKernel following the analog magnitude of the whole
+    chain: the magnitudes are sampled on an FFT grid, given a pure delay of
+    half the kernel, transformed back and windowed.
+
+    Keeps its FFTs and work buffers between calls, so after the first design
+    at a given length it doesn't allocate.
+*/
+class LinearPhaseKernelDesigner
+{
+public:
+	void design (const ChannelSettings& channelSettings, double sampleRate, int length, LinearPhaseKernel& kernel);
+	
+private:
+	std::unique_ptr<juce::dsp::FFT> kernelFFT, partitionFFT;
+	std::vector<float> kernelBuffer, partitionBuffer;
+	std::vector<double> frequencies, magnitudes;
+};
+
+//==============================================================================
+/**
+    Runs a LinearPhaseKernel over a block with uniformly partitioned
+    overlap-save convolution.
+
+    Every partitionSize samples the newest input is transformed once and
+    multiplied against each kernel partition in a frequency-domain delay line,
+    so the cost per sample is one FFT of 2 * partitionSize plus one complex
+    multiply-add per partition, and the latency is one partition plus half
+    the kernel.
+
+    New kernels arrive through publishKernel() from any one thread. The audio
+    thread picks them up at the next partition boundary and crossfades from
+    the old kernel's output to the new one's across that partition, without
+    allocating.
+*/
+class LinearPhaseConvolver
+{
+public:
+	static constexpr int partitionSize = 256;
+	static constexpr int maxKernelLength = 8192;
+	static constexpr int maxNumPartitions = maxKernelLength / partitionSize;
+	
+	// Each partition is transformed zero-padded to twice its length; only the
+	// non-negative frequency bins are kept.
+	static constexpr int fftOrder = 9;
+	static constexpr int fftSize = 2 * partitionSize;
+	static constexpr int numBins = partitionSize + 1;
+	
+	/** Allocates the state for numChannels channels. Not for the audio thread. */
+	void prepare (int numChannels);
+	void reset();
+	
+	/** Replaces the kernel outright. Only while the audio thread is stopped. */
+	void setKernel (const LinearPhaseKernel& kernel);
+	
+	/** Hands a new kernel to the audio thread. Single producer only. */
+	void publishKernel (const LinearPhaseKernel& kernel)	{ kernels.write(kernel); }
+	
+	/** Filters the block in place. Kernels designed for another rate are ignored.
+		The convolution itself always runs in float.
+	*/
+	template <typename SampleType>
+	void process (const juce::dsp::AudioBlock<SampleType>& block, double sampleRate) noexcept;
+	
+	int getLatencyInSamples() const noexcept				{ return partitionSize + currentKernel->length / 2; }
+	int getKernelLength() const noexcept					{ return currentKernel->length; }
+	
+private:
+	struct ChannelState
+	{
+		std::vector<float> inputWindow, output;
+		std::vector<std::complex<float>> delayLine;
+	};
+	
+	void processPartition (double sampleRate) noexcept;
+	void convolve (const ChannelState& state, const LinearPhaseKernel& kernel, float* output) noexcept;
+	
+	// Built by the first prepare(), like the rest of the state, so an instance
+	// that never runs linear phase doesn't pay for any of it.
+	std::unique_ptr<juce::dsp::FFT> fft;
+	std::vector<ChannelState> channels;
+	std::vector<float> fftBuffer, previousOutput;
+	int position { 0 }, delayLineHead { 0 };
+	
+	LinearPhaseKernel initialKernel;
+	const LinearPhaseKernel* currentKernel { &initialKernel };
+	TripleBuffer<LinearPhaseKernel> kernels;
+	
+	static_assert ((1 << fftOrder) == fftSize, "FFT order doesn't match the partition size");
+	
+	JUCE_DECLARE_NON_COPYABLE (LinearPhaseConvolver)
+};
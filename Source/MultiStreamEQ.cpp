@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    MultiStreamEQ.cpp
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#include "MultiStreamEQ.h"
+
+//==============================================================================
+void MultiStreamEQ::prepare (double newSampleRate, int newNumStreams)
+{
+	jassert(newSampleRate > 0.0 && newNumStreams >= 0);
+	
+	sampleRate = newSampleRate;
+	numStreams = newNumStreams;
+	
+	groups.clear();
+	groups.resize((size_t) ((numStreams + streamsPerGroup - 1) / streamsPerGroup));
+}
+
+void MultiStreamEQ::reset() noexcept
+{
+	for (auto& group : groups)
+		group.cascade.reset();
+}
+
+void MultiStreamEQ::setStreamSettings (int stream, const ChannelSettings& channelSettings) noexcept
+{
+	jassert(juce::isPositiveAndBelow(stream, numStreams));
+	
+	const auto chainCoefficients = makeChainCoefficients(channelSettings, sampleRate);
+	const Coefficients unity { 1.0, 0.0, 0.0, 1.0, 0.0, 0.0 };
+	
+	auto& group = groups[(size_t) (stream / streamsPerGroup)];
+	const auto lane = (size_t) (stream % streamsPerGroup);
+	juce::uint32 mask = 0;
+	
+	auto setSection = [&] (int index, const Coefficients& coefficients, bool isNeeded)
+	{
+		group.cascade.setSection(index, lane, isNeeded ? coefficients : unity);
+		mask |= isNeeded ? (1u << index) : 0u;
+	};
+	
+	// The same sections the processor enables for these settings.
+	for (int i = 0; i < (int) chainCoefficients.lowCut.size(); ++i)
+	{
+		setSection(ChainPositions::Lowcut + i, chainCoefficients.lowCut[(size_t) i], i < getNumCutSections(chainCoefficients.lowCutSlope));
+		setSection(ChainPositions::HighCut + i, chainCoefficients.highCut[(size_t) i], i < getNumCutSections(chainCoefficients.highCutSlope));
+	}
+	
+	for (int i = 0; i < maxNumBands; ++i)
+		setSection(ChainPositions::Bands + i, chainCoefficients.bands[(size_t) i], chainCoefficients.enabledBands[(size_t) i]);
+	
+	group.sectionMasks[lane] = mask;
+	updateEnabledSections(group);
+}
+
+void MultiStreamEQ::updateEnabledSections (Group& group) noexcept
+{
+	juce::uint32 sectionsInUse = 0;
+	
+	for (auto mask : group.sectionMasks)
+		sectionsInUse |= mask;
+	
+	for (int index = 0; index < Cascade::maxNumSections; ++index)
+		group.cascade.setSectionEnabled(index, (sectionsInUse & (1u << index)) != 0);
+}
+
+void MultiStreamEQ::process (float* const* streams, int numSamples) noexcept
+{
+	juce::ScopedNoDenormals noDenormals;
+	
+	for (size_t g = 0; g < groups.size(); ++g)
+	{
+		const auto firstStream = (int) g * streamsPerGroup;
+		const auto numStreamsInGroup = juce::jmin(streamsPerGroup, numStreams - firstStream);
+		
+		juce::dsp::AudioBlock<float> block (streams + firstStream, (size_t) numStreamsInGroup, (size_t) numSamples);
+		groups[g].cascade.process(juce::dsp::ProcessContextReplacing<float>(block));
+	}
+}
@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    MultiStreamEQ.h
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BiquadCascade.h"
+#include "ChainDesign.h"
+
+//==============================================================================
+/**
+    The EQ's minimum-phase chain for many independent mono streams at once, for
+    embedding outside a plugin host, e.g. on a server.
+
+    Streams are packed into groups of BiquadCascade::maxNumChannels, one stream
+    per SIMD lane, and every lane has coefficients of its own. A group runs each
+    section any of its streams needs, with unity coefficients in the lanes that
+    don't, so a group of unrelated streams costs about what one stream does,
+    with no processor, parameter tree or design thread per stream.
+
+    prepare() allocates. setStreamSettings() designs in place without allocating
+    or locking, and process() is realtime-safe; both are meant to be called from
+    the same thread. Smoothing, oversampling and the linear-phase mode belong to
+    the plugin and aren't offered here: new settings apply from the next call
+    to process().
+*/
+class MultiStreamEQ
+{
+public:
+	using Cascade = BiquadCascade<float>;
+	static constexpr int streamsPerGroup = (int) Cascade::maxNumChannels;
+	
+	MultiStreamEQ() = default;
+	
+	/** Makes room for numStreams streams, all at the one sample rate. Streams
+		pass through unchanged until they're given settings.
+	*/
+	void prepare (double sampleRate, int numStreams);
+	
+	/** Clears the filter state of every stream, keeping their settings. */
+	void reset() noexcept;
+	
+	int getNumStreams() const noexcept		{ return numStreams; }
+	int getNumGroups() const noexcept		{ return (int) groups.size(); }
+	
+	void setStreamSettings (int stream, const ChannelSettings& channelSettings) noexcept;
+	
+	/** Filters numSamples of every stream in place; streams[i] is stream i. */
+	void process (float* const* streams, int numSamples) noexcept;
+
+private:
+	struct Group
+	{
+		Cascade cascade;
+		
+		// The sections each lane needs, one bit per cascade slot.
+		std::array<juce::uint32, (size_t) streamsPerGroup> sectionMasks {};
+	};
+	
+	std::vector<Group> groups;
+	double sampleRate { 0.0 };
+	int numStreams { 0 };
+	
+	static void updateEnabledSections (Group& group) noexcept;
+	
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MultiStreamEQ)
+};
@@ -1,40 +1,184 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin editor.
-
-  ==============================================================================
-*/
-
-#include "PluginProcessor.h"
-#include "PluginEditor.h"
-
-//==============================================================================
-AwesomeEQAudioProcessorEditor::AwesomeEQAudioProcessorEditor (AwesomeEQAudioProcessor& p)
-    : AudioProcessorEditor (&p), audioProcessor (p)
-{
-    // Make sure that before the constructor has finished, you've set the
-    // editor's size to whatever you need it to be.
-    setSize (400, 300);
-}
-
-AwesomeEQAudioProcessorEditor::~AwesomeEQAudioProcessorEditor()
-{
-}
-
-//==============================================================================
-void AwesomeEQAudioProcessorEditor::paint (juce::Graphics& g)
-{
-    // (Our component is opaque, so we must completely fill the background with a solid colour)
-    g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId));
-
-    g.setColour (juce::Colours::white);
-    g.setFont (15.0f);
-    g.drawFittedText ("Hello World!", getLocalBounds(), juce::Justification::centred, 1);
-}
-
-void AwesomeEQAudioProcessorEditor::resized()
-{
-    // This is generally where you'll want to lay out the positions of any
-    // subcomponents in your editor..
-}
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin editor.
+
+  ==============================================================================
+*/
+
+#include "PluginProcessor.h"
+#include "PluginEditor.h"
+
+//==============================================================================
+AwesomeEQAudioProcessorEditor::AwesomeEQAudioProcessorEditor (AwesomeEQAudioProcessor& p)
+    : AudioProcessorEditor (&p), audioProcessor (p), spectrumAnalyzer (p), responseCurve (p)
+{
+	addAndMakeVisible(spectrumAnalyzer);
+	addAndMakeVisible(responseCurve);
+	
+	for (auto* parameter : audioProcessor.getParameters())
+	{
+		auto* withID = dynamic_cast<juce::AudioProcessorParameterWithID*>(parameter);
+		
+		if (withID == nullptr)
+			continue;
+		
+		auto* control = controls.add(new ParameterControl());
+		
+		if (withID->paramID.startsWith("Band"))
+			control->band = (int) (withID->paramID[4] - '1');
+		
+		control->label.setText(withID->getName(64), juce::dontSendNotification);
+		control->label.setJustificationType(juce::Justification::centred);
+		addAndMakeVisible(control->label);
+		
+		if (auto* choice = dynamic_cast<juce::AudioParameterChoice*>(parameter))
+		{
+			control->comboBox = std::make_unique<juce::ComboBox>();
+			control->comboBox->addItemList(choice->choices, 1);
+			addAndMakeVisible(*control->comboBox);
+			control->comboBoxAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(audioProcessor.parameters, withID->paramID, *control->comboBox);
+		}
+		else if (dynamic_cast<juce::AudioParameterBool*>(parameter) != nullptr)
+		{
+			control->toggleButton = std::make_unique<juce::ToggleButton>();
+			addAndMakeVisible(*control->toggleButton);
+			control->buttonAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(audioProcessor.parameters, withID->paramID, *control->toggleButton);
+		}
+		else
+		{
+			control->slider = std::make_unique<juce::Slider>(juce::Slider::RotaryHorizontalVerticalDrag, juce::Slider::TextBoxBelow);
+			addAndMakeVisible(*control->slider);
+			control->sliderAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(audioProcessor.parameters, withID->paramID, *control->slider);
+		}
+	}
+	
+	for (int band = 0; band < maxNumBands; ++band)
+		bandSelector.addItem("Band " + juce::String(band + 1), band + 1);
+	
+	bandSelector.onChange = [this] { showBand(bandSelector.getSelectedItemIndex()); };
+	addAndMakeVisible(bandSelector);
+	bandSelector.setSelectedItemIndex(0, juce::dontSendNotification);
+	showBand(0);
+	
+	metricsLabel.setFont(juce::Font(12.f));
+	metricsLabel.setColour(juce::Label::textColourId, juce::Colours::grey);
+	addAndMakeVisible(metricsLabel);
+	
+	meterLabel.setFont(juce::Font(12.f));
+	meterLabel.setColour(juce::Label::textColourId, juce::Colours::grey);
+	addAndMakeVisible(meterLabel);
+	startTimerHz(4);
+	
+    setSize (900, 500);
+}
+
+AwesomeEQAudioProcessorEditor::~AwesomeEQAudioProcessorEditor()
+{
+}
+
+//==============================================================================
+void AwesomeEQAudioProcessorEditor::paint (juce::Graphics& g)
+{
+    // (Our component is opaque, so we must completely fill the background with a solid colour)
+    g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId));
+}
+
+void AwesomeEQAudioProcessorEditor::resized()
+{
+	auto bounds = getLocalBounds().reduced(8);
+	metricsLabel.setBounds(bounds.removeFromBottom(16));
+	meterLabel.setBounds(bounds.removeFromBottom(16));
+	
+	spectrumAnalyzer.setBounds(bounds.removeFromTop(bounds.getHeight() * 3 / 5));
+	responseCurve.setBounds(spectrumAnalyzer.getBounds());
+	bounds.removeFromTop(8);
+	
+	// The band selector takes the first column, then every control on show.
+	int numColumns = 1;
+	
+	for (auto* control : controls)
+		numColumns += control->label.isVisible() ? 1 : 0;
+	
+	const auto columnWidth = bounds.getWidth() / numColumns;
+	
+	auto selectorColumn = bounds.removeFromLeft(columnWidth).reduced(2, 0);
+	selectorColumn.removeFromTop(20);
+	bandSelector.setBounds(selectorColumn.removeFromTop(24));
+	
+	for (auto* control : controls)
+	{
+		if (! control->label.isVisible())
+			continue;
+		
+		auto column = bounds.removeFromLeft(columnWidth).reduced(2, 0);
+		control->label.setBounds(column.removeFromTop(20));
+		
+		if (control->comboBox != nullptr)
+			control->comboBox->setBounds(column.removeFromTop(24));
+		else if (control->toggleButton != nullptr)
+			control->toggleButton->setBounds(column.removeFromTop(24));
+		else
+			control->slider->setBounds(column);
+	}
+}
+
+void AwesomeEQAudioProcessorEditor::showBand (int band)
+{
+	for (auto* control : controls)
+	{
+		if (control->band < 0)
+			continue;
+		
+		const auto isShown = control->band == band;
+		control->label.setVisible(isShown);
+		
+		for (auto* component : { static_cast<juce::Component*>(control->slider.get()), static_cast<juce::Component*>(control->comboBox.get()), static_cast<juce::Component*>(control->toggleButton.get()) })
+			if (component != nullptr)
+				component->setVisible(isShown);
+	}
+	
+	resized();
+}
+
+void AwesomeEQAudioProcessorEditor::timerCallback()
+{
+	const auto metrics = audioProcessor.getMetrics();
+	
+	auto text = "DSP " + juce::String(metrics.averageDeadlineUsed * 100.0, 1) + "% (peak " + juce::String(metrics.peakDeadlineUsed * 100.0, 1) + "%)"
+			  + "   Overruns " + juce::String(metrics.numOverruns)
+			  + "   Designs " + juce::String(metrics.numDesigns)
+			  + "   Sections " + juce::String(metrics.numActiveSections) + " x " + juce::String(metrics.numChains) + " channels";
+	
+	if (metrics.numDenormalBlocks > 0)
+		text << "   Denormal blocks " << juce::String(metrics.numDenormalBlocks);
+	
+	metricsLabel.setText(text, juce::dontSendNotification);
+	
+	const auto meteringMode = static_cast<MeteringMode>(audioProcessor.parameters.getRawParameterValue("Metering")->load());
+	
+	if (meteringMode == Metering_Off)
+	{
+		meterLabel.setText({}, juce::dontSendNotification);
+		return;
+	}
+	
+	const auto readings = audioProcessor.getMeterReadings();
+	
+	auto describe = [] (const LevelMeter::Levels& levels)
+	{
+		return juce::String(levels.rms, 1) + " dB RMS, " + juce::String(levels.truePeak, 1) + " dBTP";
+	};
+	
+	// Analysis only never measures the output, which is the input anyway.
+	auto meterText = "In " + describe(readings.input);
+	
+	if (meteringMode == Metering_On)
+		meterText << "   Out " << describe(readings.output);
+	
+	for (size_t i = 0; i < readings.bandEnergy.size(); ++i)
+		if (readings.measuredBands[i])
+			meterText << "   B" << (int) i + 1 << " " << juce::String(readings.bandEnergy[i], 1) << " dB";
+	
+	meterLabel.setText(meterText, juce::dontSendNotification);
+}
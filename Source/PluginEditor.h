@@ -1,33 +1,66 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin editor.
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include "PluginProcessor.h"
-
-//==============================================================================
-/**
-*/
-class AwesomeEQAudioProcessorEditor  : public juce::AudioProcessorEditor
-{
-public:
-    AwesomeEQAudioProcessorEditor (AwesomeEQAudioProcessor&);
-    ~AwesomeEQAudioProcessorEditor() override;
-
-    //==============================================================================
-    void paint (juce::Graphics&) override;
-    void resized() override;
-
-private:
-    // This reference is provided as a quick way for your editor to
-    // access the processor object that created it.
-    AwesomeEQAudioProcessor& audioProcessor;
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AwesomeEQAudioProcessorEditor)
-};
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin editor.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "ResponseCurve.h"
+#include "SpectrumAnalyzer.h"
+
+//==============================================================================
+/**
+*/
+class AwesomeEQAudioProcessorEditor  : public juce::AudioProcessorEditor,
+                                       private juce::Timer
+{
+public:
+    AwesomeEQAudioProcessorEditor (AwesomeEQAudioProcessor&);
+    ~AwesomeEQAudioProcessorEditor() override;
+
+    //==============================================================================
+    void paint (juce::Graphics&) override;
+    void resized() override;
+
+private:
+    // This reference is provided as a quick way for your editor to
+    // access the processor object that created it.
+    AwesomeEQAudioProcessor& audioProcessor;
+	
+	SpectrumAnalyzerComponent spectrumAnalyzer;
+	ResponseCurveComponent responseCurve;
+	
+	// One labelled knob, menu or switch per parameter, attached to the value tree.
+	// Band controls are only shown while their band is selected.
+	struct ParameterControl
+	{
+		juce::Label label;
+		std::unique_ptr<juce::Slider> slider;
+		std::unique_ptr<juce::ComboBox> comboBox;
+		std::unique_ptr<juce::ToggleButton> toggleButton;
+		std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> sliderAttachment;
+		std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> comboBoxAttachment;
+		std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> buttonAttachment;
+		int band { -1 };
+	};
+	
+	juce::OwnedArray<ParameterControl> controls;
+	juce::ComboBox bandSelector;
+	
+	void showBand (int band);
+	
+	// A one-line readout of the processor's metrics, refreshed a few times a second.
+	juce::Label metricsLabel;
+	
+	// The same for the level meter, while metering is on.
+	juce::Label meterLabel;
+	
+	void timerCallback() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AwesomeEQAudioProcessorEditor)
+};
@@ -1,466 +1,1316 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin processor.
-
-  ==============================================================================
-*/
-
-#include "PluginProcessor.h"
-#include "PluginEditor.h"
-
-//==============================================================================
-AwesomeEQAudioProcessor::AwesomeEQAudioProcessor()
-#ifndef JucePlugin_PreferredChannelConfigurations
-     : AudioProcessor (BusesProperties()
-                     #if ! JucePlugin_IsMidiEffect
-                      #if ! JucePlugin_IsSynth
-                       .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
-                      #endif
-                       .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
-                     #endif
-                       )
-#endif
-{
-}
-
-AwesomeEQAudioProcessor::~AwesomeEQAudioProcessor()
-{
-}
-
-//==============================================================================
-const juce::String AwesomeEQAudioProcessor::getName() const
-{
-    return JucePlugin_Name;
-}
-
-bool AwesomeEQAudioProcessor::acceptsMidi() const
-{
-   #if JucePlugin_WantsMidiInput
-    return true;
-   #else
-    return false;
-   #endif
-}
-
-bool AwesomeEQAudioProcessor::producesMidi() const
-{
-   #if JucePlugin_ProducesMidiOutput
-    return true;
-   #else
-    return false;
-   #endif
-}
-
-bool AwesomeEQAudioProcessor::isMidiEffect() const
-{
-   #if JucePlugin_IsMidiEffect
-    return true;
-   #else
-    return false;
-   #endif
-}
-
-double AwesomeEQAudioProcessor::getTailLengthSeconds() const
-{
-    return 0.0;
-}
-
-int AwesomeEQAudioProcessor::getNumPrograms()
-{
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
-}
-
-int AwesomeEQAudioProcessor::getCurrentProgram()
-{
-    return 0;
-}
-
-void AwesomeEQAudioProcessor::setCurrentProgram (int index)
-{
-}
-
-const juce::String AwesomeEQAudioProcessor::getProgramName (int index)
-{
-    return {};
-}
-
-void AwesomeEQAudioProcessor::changeProgramName (int index, const juce::String& newName)
-{
-}
-
-//==============================================================================
-void AwesomeEQAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
-{
-    // Use this method as the place to do any pre-playback
-    // initialisation that you need..
-	juce::dsp::ProcessSpec spec;
-	spec.maximumBlockSize = samplesPerBlock;
-	spec.numChannels = 1;
-	spec.sampleRate = sampleRate;
-	
-	leftChannel.prepare(spec);
-	rightChannel.prepare(spec);
-	
-	auto channelSettings = getChannelSettings(parameters);
-	auto peakCoefficients = juce::dsp::IIR::Coefficients<float>::makePeakFilter(sampleRate, channelSettings.peakFreq, channelSettings.peakQuality, juce::Decibels::decibelsToGain(channelSettings.peakGainInDecibels));
-	
-	*leftChannel.get<ChainPositions::Peak>().coefficients = *peakCoefficients;
-	*rightChannel.get<ChainPositions::Peak>().coefficients = *peakCoefficients;
-	
-	auto cutCoefficient = juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(channelSettings.lowCutFreq,sampleRate, (channelSettings.lowCutSlope + 1) * 2);
-	
-	auto &leftLowcut = leftChannel.get<ChainPositions::Lowcut>();
-	leftLowcut.setBypassed<0>(true);
-	leftLowcut.setBypassed<1>(true);
-	leftLowcut.setBypassed<2>(true);
-	leftLowcut.setBypassed<3>(true);
-	
-	switch (channelSettings.lowCutSlope)
-	{
-		case Slope_12:
-		{
-			*leftLowcut.get<0>().coefficients = *cutCoefficient[0];
-			leftLowcut.setBypassed<0>(false);
-			break;
-		}
-			
-		case Slope_24:
-		{
-			
-			*leftLowcut.get<0>().coefficients = *cutCoefficient[0];
-			leftLowcut.setBypassed<0>(false);
-			*leftLowcut.get<1>().coefficients = *cutCoefficient[1];
-			leftLowcut.setBypassed<1>(false);
-			break;
-		}
-			
-		case Slope_36:
-		{
-			*leftLowcut.get<0>().coefficients = *cutCoefficient[0];
-			leftLowcut.setBypassed<0>(false);
-			*leftLowcut.get<1>().coefficients = *cutCoefficient[1];
-			leftLowcut.setBypassed<1>(false);
-			*leftLowcut.get<2>().coefficients = *cutCoefficient[2];
-			leftLowcut.setBypassed<2>(false);
-			break;
-		}
-			
-		case Slope_48:
-		{
-			*leftLowcut.get<0>().coefficients = *cutCoefficient[0];
-			leftLowcut.setBypassed<0>(false);
-			*leftLowcut.get<1>().coefficients = *cutCoefficient[1];
-			leftLowcut.setBypassed<1>(false);
-			*leftLowcut.get<2>().coefficients = *cutCoefficient[2];
-			leftLowcut.setBypassed<2>(false);
-			*leftLowcut.get<3>().coefficients = *cutCoefficient[3];
-			leftLowcut.setBypassed<3>(false);
-			break;
-		}
-	}
-	
-	
-	
-	
-	auto &rightLowcut = rightChannel.get<ChainPositions::Lowcut>();
-	rightLowcut.setBypassed<0>(true);
-	rightLowcut.setBypassed<1>(true);
-	rightLowcut.setBypassed<2>(true);
-	rightLowcut.setBypassed<3>(true);
-	
-	switch (channelSettings.lowCutSlope)
-	{
-		case Slope_12:
-		{
-			*rightLowcut.get<0>().coefficients = *cutCoefficient[0];
-			rightLowcut.setBypassed<0>(false);
-			break;
-		}
-			
-		case Slope_24:
-		{
-			
-			*rightLowcut.get<0>().coefficients = *cutCoefficient[0];
-			rightLowcut.setBypassed<0>(false);
-			*rightLowcut.get<1>().coefficients = *cutCoefficient[1];
-			rightLowcut.setBypassed<1>(false);
-			break;
-		}
-			
-		case Slope_36:
-		{
-			*rightLowcut.get<0>().coefficients = *cutCoefficient[0];
-			rightLowcut.setBypassed<0>(false);
-			*rightLowcut.get<1>().coefficients = *cutCoefficient[1];
-			rightLowcut.setBypassed<1>(false);
-			*rightLowcut.get<2>().coefficients = *cutCoefficient[2];
-			rightLowcut.setBypassed<2>(false);
-			break;
-		}
-			
-		case Slope_48:
-		{
-			*rightLowcut.get<0>().coefficients = *cutCoefficient[0];
-			rightLowcut.setBypassed<0>(false);
-			*rightLowcut.get<1>().coefficients = *cutCoefficient[1];
-			rightLowcut.setBypassed<1>(false);
-			*rightLowcut.get<2>().coefficients = *cutCoefficient[2];
-			rightLowcut.setBypassed<2>(false);
-			*rightLowcut.get<3>().coefficients = *cutCoefficient[3];
-			rightLowcut.setBypassed<3>(false);
-			break;
-		}
-	}
-}
-
-void AwesomeEQAudioProcessor::releaseResources()
-{
-    // When playback stops, you can use this as an opportunity to free up any
-    // spare memory, etc.
-}
-
-#ifndef JucePlugin_PreferredChannelConfigurations
-bool AwesomeEQAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
-{
-  #if JucePlugin_IsMidiEffect
-    juce::ignoreUnused (layouts);
-    return true;
-  #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
-        return false;
-
-    // This checks if the input layout matches the output layout
-   #if ! JucePlugin_IsSynth
-    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
-        return false;
-   #endif
-
-    return true;
-  #endif
-}
-#endif
-
-void AwesomeEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
-{
-    juce::ScopedNoDenormals noDenormals;
-    auto totalNumInputChannels  = getTotalNumInputChannels();
-    auto totalNumOutputChannels = getTotalNumOutputChannels();
-
-    // In case we have more outputs than inputs, this code clears any output
-    // channels that didn't contain input data, (because these aren't
-    // guaranteed to be empty - they may contain garbage).
-    // This is here to avoid people getting screaming feedback
-    // when they first compile a plugin, but obviously you don't need to keep
-    // this code if your algorithm always overwrites all the output channels.
-    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-        buffer.clear (i, 0, buffer.getNumSamples());
-	
-	auto channelSettings = getChannelSettings(parameters);
-	auto peakCoefficients = juce::dsp::IIR::Coefficients<float>::makePeakFilter(getSampleRate(), channelSettings.peakFreq, channelSettings.peakQuality, juce::Decibels::decibelsToGain(channelSettings.peakGainInDecibels));
-	
-	
-	auto cutCoefficient = juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(channelSettings.lowCutFreq, getSampleRate(), (channelSettings.lowCutSlope + 1) * 2);
-	
-	auto &leftLowcut = leftChannel.get<ChainPositions::Lowcut>();
-	leftLowcut.setBypassed<0>(true);
-	leftLowcut.setBypassed<1>(true);
-	leftLowcut.setBypassed<2>(true);
-	leftLowcut.setBypassed<3>(true);
-	
-	switch (channelSettings.lowCutSlope)
-	{
-		case Slope_12:
-		{
-			*leftLowcut.get<0>().coefficients = *cutCoefficient[0];
-			leftLowcut.setBypassed<0>(false);
-			break;
-		}
-			
-		case Slope_24:
-		{
-			
-			*leftLowcut.get<0>().coefficients = *cutCoefficient[0];
-			leftLowcut.setBypassed<0>(false);
-			*leftLowcut.get<1>().coefficients = *cutCoefficient[1];
-			leftLowcut.setBypassed<1>(false);
-			break;
-		}
-			
-		case Slope_36:
-		{
-			*leftLowcut.get<0>().coefficients = *cutCoefficient[0];
-			leftLowcut.setBypassed<0>(false);
-			*leftLowcut.get<1>().coefficients = *cutCoefficient[1];
-			leftLowcut.setBypassed<1>(false);
-			*leftLowcut.get<2>().coefficients = *cutCoefficient[2];
-			leftLowcut.setBypassed<2>(false);
-			break;
-		}
-			
-		case Slope_48:
-		{
-			*leftLowcut.get<0>().coefficients = *cutCoefficient[0];
-			leftLowcut.setBypassed<0>(false);
-			*leftLowcut.get<1>().coefficients = *cutCoefficient[1];
-			leftLowcut.setBypassed<1>(false);
-			*leftLowcut.get<2>().coefficients = *cutCoefficient[2];
-			leftLowcut.setBypassed<2>(false);
-			*leftLowcut.get<3>().coefficients = *cutCoefficient[3];
-			leftLowcut.setBypassed<3>(false);
-			break;
-		}
-	}
-	
-	
-	
-	
-	auto &rightLowcut = rightChannel.get<ChainPositions::Lowcut>();
-	rightLowcut.setBypassed<0>(true);
-	rightLowcut.setBypassed<1>(true);
-	rightLowcut.setBypassed<2>(true);
-	rightLowcut.setBypassed<3>(true);
-	
-	switch (channelSettings.lowCutSlope)
-	{
-		case Slope_12:
-		{
-			*rightLowcut.get<0>().coefficients = *cutCoefficient[0];
-			rightLowcut.setBypassed<0>(false);
-			break;
-		}
-			
-		case Slope_24:
-		{
-			
-			*rightLowcut.get<0>().coefficients = *cutCoefficient[0];
-			rightLowcut.setBypassed<0>(false);
-			*rightLowcut.get<1>().coefficients = *cutCoefficient[1];
-			rightLowcut.setBypassed<1>(false);
-			break;
-		}
-			
-		case Slope_36:
-		{
-			*rightLowcut.get<0>().coefficients = *cutCoefficient[0];
-			rightLowcut.setBypassed<0>(false);
-			*rightLowcut.get<1>().coefficients = *cutCoefficient[1];
-			rightLowcut.setBypassed<1>(false);
-			*rightLowcut.get<2>().coefficients = *cutCoefficient[2];
-			rightLowcut.setBypassed<2>(false);
-			break;
-		}
-			
-		case Slope_48:
-		{
-			*rightLowcut.get<0>().coefficients = *cutCoefficient[0];
-			rightLowcut.setBypassed<0>(false);
-			*rightLowcut.get<1>().coefficients = *cutCoefficient[1];
-			rightLowcut.setBypassed<1>(false);
-			*rightLowcut.get<2>().coefficients = *cutCoefficient[2];
-			rightLowcut.setBypassed<2>(false);
-			*rightLowcut.get<3>().coefficients = *cutCoefficient[3];
-			rightLowcut.setBypassed<3>(false);
-			break;
-		}
-	}
-	
-	*leftChannel.get<ChainPositions::Peak>().coefficients = *peakCoefficients;
-	*rightChannel.get<ChainPositions::Peak>().coefficients = *peakCoefficients;
-
-	juce::dsp::AudioBlock<float> block(buffer);
-	auto leftBlock = block.getSingleChannelBlock(0);
-	auto rightBlock = block.getSingleChannelBlock(1);
-	juce::dsp::ProcessContextReplacing<float> leftContext(leftBlock);
-	juce::dsp::ProcessContextReplacing<float> rightContext(rightBlock);
-	leftChannel.process(leftContext);
-	rightChannel.process(rightContext);
-	
-	
-	
-}
-
-//==============================================================================
-bool AwesomeEQAudioProcessor::hasEditor() const
-{
-    return true; // (change this to false if you choose to not supply an editor)
-}
-
-juce::AudioProcessorEditor* AwesomeEQAudioProcessor::createEditor()
-{
-	return new juce::GenericAudioProcessorEditor(*this);
-}
-
-//==============================================================================
-void AwesomeEQAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
-{
-    // You should use this method to store your parameters in the memory block.
-    // You could do that either as raw data, or use the XML or ValueTree classes
-    // as intermediaries to make it easy to save and load complex data.
-}
-
-void AwesomeEQAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
-{
-    // You should use this method to restore your parameters from this memory block,
-    // whose contents will have been created by the getStateInformation() call.
-}
-
-ChannelSettings getChannelSettings (juce::AudioProcessorValueTreeState& parameters)
-{
-	ChannelSettings settings;
-	
-	settings.lowCutFreq = parameters.getRawParameterValue("Lowcut Freq") ->load();
-	settings.highCutFreq = parameters.getRawParameterValue("Highcut Freq") ->load();
-	settings.peakFreq = parameters.getRawParameterValue("Peak Freq") ->load();
-	settings.peakGainInDecibels = parameters.getRawParameterValue("Peak Gain") ->load();
-	settings.peakQuality = parameters.getRawParameterValue("Peak Quality") ->load();
-	settings.lowCutSlope = static_cast<Slope>(parameters.getRawParameterValue("Lowcut Slope") ->load());
-	settings.highCutSlope = static_cast<Slope>(parameters.getRawParameterValue("Highcut Slope") ->load());
-	
-	return settings;
-}
-
-juce::AudioProcessorValueTreeState::ParameterLayout AwesomeEQAudioProcessor::createParameterLayout()
-{
-	juce::AudioProcessorValueTreeState::ParameterLayout layout;
-	layout.add(std::make_unique<juce::AudioParameterFloat>("Lowcut Freq", "Lowcut Freq", juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f), 20.f ));
-	
-	layout.add(std::make_unique<juce::AudioParameterFloat>("Highcut Freq", "Highcut Freq", juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f), 20000.f ));
-	
-	layout.add(std::make_unique<juce::AudioParameterFloat>("Peak Freq", "Peak Freq", juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f), 750.f ));
-	
-	layout.add(std::make_unique<juce::AudioParameterFloat>("Peak Gain", "Peak Gain", juce::NormalisableRange<float>(-36.f, 36.f, 0.5f, 1.f), 0.0f ));
-	
-	layout.add(std::make_unique<juce::AudioParameterFloat>("Peak Quality", "Peak Quality", juce::NormalisableRange<float>(0.1f, 10.f, 0.05f, 1.f), 1.f ));
-	
-	
-	
-	juce::StringArray stringArray;
-	
-	for (int i = 0; i < 4; i++)
-	{
-		juce::String str;
-		str << (12 + i * 12);
-		str << " db/Oct";
-		
-		stringArray.add(str);
-	}
-	
-	layout.add (std::make_unique<juce::AudioParameterChoice>("Lowcut Slope", "Lowcut Slope", stringArray, 0));
-	layout.add (std::make_unique<juce::AudioParameterChoice>("Highcut Slope", "Highcut Slope", stringArray, 0));
-	
-	return layout;
-}
-
-//==============================================================================
-// This creates new instances of the plugin..
-juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
-{
-    return new AwesomeEQAudioProcessor();
-}
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin processor.
+
+  ==============================================================================
+*/
+
+#include "PluginProcessor.h"
+#include "PluginEditor.h"
+
+//==============================================================================
+AwesomeEQAudioProcessor::AwesomeEQAudioProcessor()
+#ifndef JucePlugin_PreferredChannelConfigurations
+     : AudioProcessor (BusesProperties()
+                     #if ! JucePlugin_IsMidiEffect
+                      #if ! JucePlugin_IsSynth
+                       .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
+                       .withInput  ("Sidechain", juce::AudioChannelSet::stereo(), false)
+                      #endif
+                       .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
+                     #endif
+                       )
+#endif
+{
+	for (auto& needsUpdate : bandNeedsUpdate)
+		needsUpdate = true;
+	
+	for (auto* parameter : getParameters())
+		if (auto* withID = dynamic_cast<juce::AudioProcessorParameterWithID*>(parameter))
+			parameters.addParameterListener(withID->paramID, this);
+	
+	designThread->addClient(this);
+}
+
+AwesomeEQAudioProcessor::~AwesomeEQAudioProcessor()
+{
+	designThread->removeClient(this);
+	
+	for (auto* parameter : getParameters())
+		if (auto* withID = dynamic_cast<juce::AudioProcessorParameterWithID*>(parameter))
+			parameters.removeParameterListener(withID->paramID, this);
+}
+
+//==============================================================================
+const juce::String AwesomeEQAudioProcessor::getName() const
+{
+    return JucePlugin_Name;
+}
+
+bool AwesomeEQAudioProcessor::acceptsMidi() const
+{
+   #if JucePlugin_WantsMidiInput
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+bool AwesomeEQAudioProcessor::producesMidi() const
+{
+   #if JucePlugin_ProducesMidiOutput
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+bool AwesomeEQAudioProcessor::isMidiEffect() const
+{
+   #if JucePlugin_IsMidiEffect
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+double AwesomeEQAudioProcessor::getTailLengthSeconds() const
+{
+	// A linear-phase kernel rings for exactly its length after the latency;
+	// the IIR chain for as long as its most resonant section takes to decay.
+	if (getPhaseMode() == Phase_Linear && getSampleRate() > 0.0)
+	{
+		const auto kernelLength = getKernelLength(static_cast<KernelLength>(kernelLengthValue->load()));
+		return (double) (LinearPhaseConvolver::partitionSize + kernelLength) / getSampleRate();
+	}
+	
+	// A dynamic band can be cut further than its own gain, so it rings for as
+	// long as whichever end of its range rings longest.
+	auto channelSettings = channelParameters.load();
+	auto ringingTime = getRingingTimeSeconds(channelSettings);
+	
+	if (static_cast<DynamicsMode>(dynamicsModeValue->load()) != Dynamics_Off)
+	{
+		channelSettings.bands[0].gainInDecibels -= DynamicBand::maxReductionInDecibels;
+		ringingTime = juce::jmax(ringingTime, getRingingTimeSeconds(channelSettings));
+	}
+	
+	return ringingTime;
+}
+
+int AwesomeEQAudioProcessor::getNumPrograms()
+{
+    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
+                // so this should be at least 1, even if you're not really implementing programs.
+}
+
+int AwesomeEQAudioProcessor::getCurrentProgram()
+{
+    return 0;
+}
+
+void AwesomeEQAudioProcessor::setCurrentProgram (int index)
+{
+}
+
+const juce::String AwesomeEQAudioProcessor::getProgramName (int index)
+{
+    return {};
+}
+
+void AwesomeEQAudioProcessor::changeProgramName (int index, const juce::String& newName)
+{
+}
+
+//==============================================================================
+void AwesomeEQAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
+{
+    // Use this method as the place to do any pre-playback
+    // initialisation that you need..
+	// Only the main bus is filtered; the sidechain just feeds band one's detector.
+	const auto numChannels = (size_t) juce::jmax(getMainBusNumInputChannels(), getMainBusNumOutputChannels());
+	
+	auto prepareOversamplers = [&] (auto& oversamplers, auto& unused)
+	{
+		using Oversampling = typename std::remove_reference<decltype(*oversamplers[0])>::type;
+		
+		for (size_t i = 0; i < oversamplers.size(); ++i)
+		{
+			oversamplers[i] = std::make_unique<Oversampling>(juce::jmax((size_t) 1, numChannels), i + 1, Oversampling::filterHalfBandPolyphaseIIR, true, true);
+			oversamplers[i]->initProcessing((size_t) samplesPerBlock);
+		}
+		
+		for (auto& oversampler : unused)
+			oversampler.reset();
+	};
+	
+	if (getProcessingPrecision() == doublePrecision)
+		prepareOversamplers(doubleOversamplers, floatOversamplers);
+	else
+		prepareOversamplers(floatOversamplers, doubleOversamplers);
+	
+	auto prepareGroups = [&] (auto& channelGroups)
+	{
+		using Cascade = typename std::remove_reference<decltype(channelGroups)>::type::value_type;
+		
+		juce::dsp::ProcessSpec spec;
+		spec.maximumBlockSize = samplesPerBlock * 4;
+		spec.numChannels = (juce::uint32) Cascade::maxNumChannels;
+		spec.sampleRate = sampleRate * 4;
+		
+		channelGroups.resize((numChannels + Cascade::maxNumChannels - 1) / Cascade::maxNumChannels);
+		
+		for (auto& group : channelGroups)
+			group.prepare(spec);
+	};
+	
+	prepareGroups(floatChannelGroups);
+	prepareGroups(doubleChannelGroups);
+	isDoubleState = getProcessingPrecision() == doublePrecision
+				 || static_cast<FilterPrecision>(filterPrecisionValue->load()) == Precision_Double;
+	
+	// Design synchronously so playback starts with valid coefficients; the
+	// design thread picks up the new rate and takes over from here on.
+	const auto factor = getOversamplingFactor(static_cast<OversamplingMode>(oversamplingValue->load()));
+	const auto chainSampleRate = sampleRate * factor;
+	
+	setOversamplingFactor(factor);
+	applyCoefficients(coefficientCache->makeChainCoefficients(channelParameters.load(), chainSampleRate));
+	isRamping = false;
+	isBypassed = false;
+	isSleeping = false;
+	silenceCountdown = -1;
+	
+	// A table designed for the current rate can stay; any other is ignored
+	// until the design thread replaces it.
+	dynamicBand.prepare(sampleRate, samplesPerBlock);
+	isDynamic = false;
+	isDynamicPublished = false;
+	
+	levelMeter.prepare(sampleRate, (int) numChannels, samplesPerBlock);
+	isAnalysisOnly = getMeteringMode() == Metering_AnalysisOnly;
+	
+	// The linear-phase path gets the same treatment, but only when it's in use.
+	// Otherwise it's left to the design thread the first time it's chosen.
+	{
+		const juce::ScopedLock sl (linearPhaseLock);
+		numLinearPhaseChannels = (int) numChannels;
+		kernelSampleRate = sampleRate;
+		isLinearPhaseReady = false;
+		
+		if (getPhaseMode() == Phase_Linear)
+			prepareLinearPhase();
+	}
+	
+	// The host reads the latency as soon as this returns, so it's told here.
+	isLinearPhase = isLinearPhaseReady && getPhaseMode() == Phase_Linear;
+	updateLatency();
+	reportLatency();
+	
+	designSampleRate = chainSampleRate;
+	maxBlockSize = samplesPerBlock;
+	metrics.reset();
+	designThread->requestDesign();
+}
+
+MeteringMode AwesomeEQAudioProcessor::getMeteringMode() const
+{
+	return static_cast<MeteringMode>(meteringValue->load());
+}
+
+PhaseMode AwesomeEQAudioProcessor::getPhaseMode() const
+{
+	return static_cast<PhaseMode>(phaseValue->load());
+}
+
+void AwesomeEQAudioProcessor::prepareLinearPhase()
+{
+	// Called with linearPhaseLock held, while the audio thread can't be using
+	// the convolver: either it's stopped, or the convolver isn't ready yet.
+	const auto length = getKernelLength(static_cast<KernelLength>(kernelLengthValue->load()));
+	kernelNeedsUpdate = false;
+	kernelDesigner.design(channelParameters.load(), kernelSampleRate, length, latestKernel);
+	
+	linearPhaseConvolver.prepare(numLinearPhaseChannels);
+	linearPhaseConvolver.setKernel(latestKernel);
+	isLinearPhaseReady = true;
+	metrics.recordKernelDesign();
+}
+
+void AwesomeEQAudioProcessor::updateLatency()
+{
+	const auto latency = isLinearPhase ? linearPhaseConvolver.getLatencyInSamples() : getOversamplingLatency();
+	
+	if (chainLatency.exchange(latency) != latency)
+		designThread->requestDesign();
+}
+
+void AwesomeEQAudioProcessor::reportLatency()
+{
+	// Analysis alone leaves the audio as it came in, so there's nothing to compensate for.
+	const auto latency = getMeteringMode() == Metering_AnalysisOnly ? 0 : chainLatency.load();
+	
+	if (latency != getLatencySamples())
+		setLatencySamples(latency);
+}
+
+double AwesomeEQAudioProcessor::getDesignSampleRate (float oversamplingParameter) const
+{
+	return getSampleRate() * getOversamplingFactor(static_cast<OversamplingMode>(oversamplingParameter));
+}
+
+template <typename SampleType>
+juce::dsp::Oversampling<SampleType>* AwesomeEQAudioProcessor::getOversampler() const
+{
+	if (oversamplingFactor == 1)
+		return nullptr;
+	
+	const auto index = (size_t) oversamplingFactor / 2 - 1;
+	
+	if constexpr (std::is_same<SampleType, double>::value)
+		return doubleOversamplers[index].get();
+	else
+		return floatOversamplers[index].get();
+}
+
+int AwesomeEQAudioProcessor::getOversamplingLatency() const
+{
+	if (auto* oversampler = getOversampler<float>())
+		return juce::roundToInt(oversampler->getLatencyInSamples());
+	
+	if (auto* oversampler = getOversampler<double>())
+		return juce::roundToInt(oversampler->getLatencyInSamples());
+	
+	return 0;
+}
+
+void AwesomeEQAudioProcessor::setOversamplingFactor (int factor)
+{
+	// Filter state from a different rate is meaningless, so start both clean.
+	oversamplingFactor = factor;
+	
+	if (auto* oversampler = getOversampler<float>())
+		oversampler->reset();
+	
+	if (auto* oversampler = getOversampler<double>())
+		oversampler->reset();
+	
+	resetChains();
+	updateLatency();
+}
+
+void AwesomeEQAudioProcessor::resetChains()
+{
+	for (auto& group : floatChannelGroups)
+		group.reset();
+	
+	for (auto& group : doubleChannelGroups)
+		group.reset();
+}
+
+void AwesomeEQAudioProcessor::releaseResources()
+{
+    // When playback stops, you can use this as an opportunity to free up any
+    // spare memory, etc.
+}
+
+#ifndef JucePlugin_PreferredChannelConfigurations
+bool AwesomeEQAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
+{
+  #if JucePlugin_IsMidiEffect
+    juce::ignoreUnused (layouts);
+    return true;
+  #else
+    // Any channel layout works, since every channel gets the same curve and
+    // the filters are grouped by SIMD width rather than by speaker position.
+    if (layouts.getMainOutputChannelSet().isDisabled())
+        return false;
+
+    // This checks if the input layout matches the output layout
+   #if ! JucePlugin_IsSynth
+    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
+        return false;
+   #endif
+
+    return true;
+  #endif
+}
+#endif
+
+bool AwesomeEQAudioProcessor::supportsDoublePrecisionProcessing() const
+{
+	return true;
+}
+
+void AwesomeEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+	juce::ignoreUnused(midiMessages);
+	auto mainBuffer = getBusBuffer(buffer, false, 0);
+	process(mainBuffer, getBusBuffer(buffer, true, 1));
+}
+
+void AwesomeEQAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+	juce::ignoreUnused(midiMessages);
+	auto mainBuffer = getBusBuffer(buffer, false, 0);
+	process(mainBuffer, getBusBuffer(buffer, true, 1));
+}
+
+template <typename SampleType>
+void AwesomeEQAudioProcessor::process (juce::AudioBuffer<SampleType>& buffer, const juce::AudioBuffer<SampleType>& sidechain)
+{
+	const auto startTicks = juce::Time::getHighResolutionTicks();
+	
+    juce::ScopedNoDenormals noDenormals;
+    auto totalNumInputChannels  = getMainBusNumInputChannels();
+    auto totalNumOutputChannels = getMainBusNumOutputChannels();
+
+    // In case we have more outputs than inputs, this code clears any output
+    // channels that didn't contain input data, (because these aren't
+    // guaranteed to be empty - they may contain garbage).
+    // This is here to avoid people getting screaming feedback
+    // when they first compile a plugin, but obviously you don't need to keep
+    // this code if your algorithm always overwrites all the output channels.
+    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
+        buffer.clear (i, 0, buffer.getNumSamples());
+	
+	updateFilters();
+	
+	const bool feedAnalyzer = analyzerAttached.load(std::memory_order_relaxed);
+	
+	if (feedAnalyzer)
+		preAnalyzerFifo.push(buffer);
+	
+	const auto numSamples = buffer.getNumSamples();
+	const auto meteringMode = getMeteringMode();
+	
+	// Measured inside the same processBlock() call, on the way in and again
+	// after the chain, so metering doesn't need an analyzer plugin of its own.
+	if (meteringMode != Metering_Off)
+		levelMeter.measureInput(buffer, numSamples);
+	
+	// Coming back from analysis, the chain starts again from silence.
+	if ((meteringMode == Metering_AnalysisOnly) != isAnalysisOnly)
+	{
+		isAnalysisOnly = ! isAnalysisOnly;
+		wakeUp();
+		isSleeping = false;
+		silenceCountdown = -1;
+	}
+	
+	if (isAnalysisOnly)
+	{
+		if (feedAnalyzer)
+			postAnalyzerFifo.push(buffer);
+		
+		recordMetrics(false, startTicks, numSamples);
+		return;
+	}
+	
+	const bool inputIsSilent = buffer.getMagnitude(0, numSamples) < (SampleType) silenceThreshold;
+	
+	if (isSleeping)
+	{
+		if (inputIsSilent)
+		{
+			buffer.clear();
+		}
+		else
+		{
+			isSleeping = false;
+			wakeUp();
+		}
+	}
+	
+	bool chainRan = false;
+	
+	if (! isSleeping)
+	{
+		// The detector has to see the block before it's filtered in place.
+		updateDynamicBand();
+		
+		if (isDynamic)
+		{
+			const auto mode = static_cast<DynamicsMode>(dynamicsModeValue->load());
+			dynamicBand.analyse(mode == Dynamics_Sidechain ? sidechain : buffer, numSamples, getDynamicsSettings());
+		}
+		
+		juce::dsp::AudioBlock<SampleType> block(buffer);
+		processFilters(block);
+		chainRan = ! isLinearPhase && ! isBypassed;
+	}
+	
+	// The countdown starts with the silence and covers the latency as well as
+	// the ring-down; the output still has to be silent when it runs out.
+	if (! inputIsSilent)
+	{
+		silenceCountdown = -1;
+	}
+	else if (! isSleeping)
+	{
+		if (silenceCountdown < 0)
+			silenceCountdown = chainLatency.load() + (int) std::ceil(getTailLengthSeconds() * getSampleRate());
+		
+		silenceCountdown = juce::jmax(0, silenceCountdown - numSamples);
+		
+		if (silenceCountdown == 0 && buffer.getMagnitude(0, numSamples) < (SampleType) silenceThreshold)
+			isSleeping = true;
+	}
+	
+	if (meteringMode == Metering_On)
+		levelMeter.measureOutput(buffer, numSamples);
+	
+	if (feedAnalyzer)
+		postAnalyzerFifo.push(buffer);
+	
+	recordMetrics(chainRan, startTicks, numSamples);
+}
+
+void AwesomeEQAudioProcessor::recordMetrics (bool chainRan, juce::int64 startTicks, int numSamples)
+{
+	// Every channel runs the same sections in its own lane, so one count covers all the chains.
+	const auto numChains = getTotalNumOutputChannels();
+	
+	auto inspect = [&] (const auto& channelGroups)
+	{
+		if (! chainRan || channelGroups.empty())
+		{
+			metrics.setActiveSections(0, numChains);
+			return;
+		}
+		
+		metrics.setActiveSections(channelGroups.front().getNumEnabledSections(), numChains);
+		
+		for (auto& group : channelGroups)
+		{
+			if (group.hasDenormalState())
+			{
+				metrics.recordDenormals();
+				break;
+			}
+		}
+	};
+	
+	if (isDoubleState)
+		inspect(doubleChannelGroups);
+	else
+		inspect(floatChannelGroups);
+	
+	metrics.recordBlock(juce::Time::getHighResolutionTicks() - startTicks, numSamples, getSampleRate());
+}
+
+void AwesomeEQAudioProcessor::wakeUp()
+{
+	// Whatever the state decayed to is below the threshold; clearing it drops
+	// the denormal residue too, so processing resumes exactly as from silence.
+	if (auto* oversampler = getOversampler<float>())
+		oversampler->reset();
+	
+	if (auto* oversampler = getOversampler<double>())
+		oversampler->reset();
+	
+	if (isLinearPhase)
+		linearPhaseConvolver.reset();
+	
+	dynamicBand.reset();
+	resetChains();
+}
+
+template <typename SampleType>
+void AwesomeEQAudioProcessor::processFilters (juce::dsp::AudioBlock<SampleType>& block)
+{
+	// Switching phase modes changes the latency, so both paths start from silence.
+	// Until the design thread has the convolver ready the IIR chain carries on.
+	const bool linearPhase = getPhaseMode() == Phase_Linear && isLinearPhaseReady.load(std::memory_order_acquire);
+	
+	if (linearPhase != isLinearPhase)
+	{
+		isLinearPhase = linearPhase;
+		linearPhaseConvolver.reset();
+		resetChains();
+		updateLatency();
+	}
+	
+	const bool doubleState = std::is_same<SampleType, double>::value
+						  || static_cast<FilterPrecision>(filterPrecisionValue->load()) == Precision_Double;
+	
+	if (doubleState != isDoubleState)
+	{
+		isDoubleState = doubleState;
+		resetChains();
+		applyCoefficients(appliedCoefficients);
+	}
+	
+	if (isLinearPhase)
+	{
+		// A new kernel can change the length, and with it the latency.
+		const auto kernelLength = linearPhaseConvolver.getKernelLength();
+		linearPhaseConvolver.process(block, getSampleRate());
+		
+		if (linearPhaseConvolver.getKernelLength() != kernelLength)
+			updateLatency();
+		
+		return;
+	}
+	
+	// Bypassing is only safe without oversampling, whose latency the dry signal
+	// wouldn't have. Going in or out, the sections glide to or from unity over
+	// one block, so the switch doesn't click.
+	const auto design = isRamping ? targetCoefficients : appliedCoefficients;
+	const bool bypass = design.isNeutral && oversamplingFactor == 1 && ! isDynamic;
+	
+	if (bypass && isBypassed)
+		return;
+	
+	if (bypass != isBypassed)
+	{
+		if (bypass)
+		{
+			targetCoefficients = makeUnityCoefficients(design);
+		}
+		else
+		{
+			resetChains();
+			applyCoefficients(makeUnityCoefficients(design));
+			targetCoefficients = design;
+		}
+		
+		isRamping = true;
+		pendingTrajectory = nullptr;
+	}
+	
+	auto* oversampler = getOversampler<SampleType>();
+	auto chainBlock = oversampler != nullptr ? oversampler->processSamplesUp(block) : block;
+	
+	// A bypass glide happens even with smoothing off, since there's no design to jump to.
+	const auto smoothingMode = bypass != isBypassed ? Smoothing_16 : static_cast<SmoothingMode>(smoothingValue->load());
+	
+	if (! isRamping)
+		processChain(chainBlock);
+	else if (pendingTrajectory != nullptr)
+		processTrajectory(chainBlock, *pendingTrajectory, smoothingMode);
+	else
+		glideTo(chainBlock, targetCoefficients, smoothingMode);
+	
+	isRamping = false;
+	pendingTrajectory = nullptr;
+	
+	if (oversampler != nullptr)
+		oversampler->processSamplesDown(block);
+	
+	// The sections are at unity now; the real design goes back in for when the
+	// chain resumes.
+	if (bypass != isBypassed)
+	{
+		isBypassed = bypass;
+		
+		if (isBypassed)
+			applyCoefficients(design);
+	}
+}
+
+template <typename SampleType>
+void AwesomeEQAudioProcessor::glideTo (const juce::dsp::AudioBlock<SampleType>& block, const ChainCoefficients& target, SmoothingMode smoothingMode)
+{
+	// Glide from the current design to the target across the block, stepping the
+	// coefficients every few samples so large host buffers still sweep cleanly.
+	const auto startCoefficients = appliedCoefficients;
+	const auto numSamples = block.getNumSamples();
+	const auto interval = (size_t) juce::jmax(1, getSmoothingInterval(smoothingMode));
+	
+	for (size_t start = 0; start < numSamples; start += interval)
+	{
+		const auto length = juce::jmin(interval, numSamples - start);
+		const auto proportion = static_cast<float>(start + length) / static_cast<float>(numSamples);
+		
+		applyCoefficients(interpolateCoefficients(startCoefficients, target, proportion));
+		processChain(block.getSubBlock(start, length));
+	}
+	
+	applyCoefficients(target);
+}
+
+template <typename SampleType>
+void AwesomeEQAudioProcessor::processTrajectory (const juce::dsp::AudioBlock<SampleType>& block, const DesignTrajectory& trajectory, SmoothingMode smoothingMode)
+{
+	// The block is split into as many segments as the resolution allows, up to one
+	// per step, and each segment ends on the step for its share of the move. With
+	// smoothing on, the coefficients also glide within each segment.
+	const auto automationResolution = static_cast<AutomationResolution>(automationResolutionValue->load());
+	const auto interval = (size_t) juce::jmax(1, getAutomationInterval(automationResolution) * oversamplingFactor);
+	const auto numSamples = block.getNumSamples();
+	const auto numSegments = (size_t) juce::jlimit(1, trajectory.numSteps, (int) (numSamples / interval));
+	
+	for (size_t segment = 0; segment < numSegments; ++segment)
+	{
+		const auto start = segment * numSamples / numSegments;
+		const auto end = (segment + 1) * numSamples / numSegments;
+		const auto& step = trajectory.steps[(segment + 1) * (size_t) trajectory.numSteps / numSegments - 1];
+		const auto segmentBlock = block.getSubBlock(start, end - start);
+		
+		if (smoothingMode == Smoothing_Off)
+		{
+			applyCoefficients(step);
+			processChain(segmentBlock);
+		}
+		else
+		{
+			glideTo(segmentBlock, step, smoothingMode);
+		}
+	}
+}
+
+template <typename StateType, typename SampleType>
+static void processChannelGroups (std::vector<BiquadCascade<StateType>>& channelGroups, const juce::dsp::AudioBlock<SampleType>& block)
+{
+	constexpr auto groupSize = BiquadCascade<StateType>::maxNumChannels;
+	const auto numChannels = block.getNumChannels();
+	
+	for (size_t group = 0; group < channelGroups.size(); ++group)
+	{
+		const auto firstChannel = group * groupSize;
+		
+		if (firstChannel >= numChannels)
+			break;
+		
+		auto groupBlock = block.getSubsetChannelBlock(firstChannel, juce::jmin(groupSize, numChannels - firstChannel));
+		juce::dsp::ProcessContextReplacing<SampleType> context(groupBlock);
+		channelGroups[group].process(context);
+	}
+}
+
+template <typename SampleType>
+void AwesomeEQAudioProcessor::processChain (const juce::dsp::AudioBlock<SampleType>& block)
+{
+	auto run = [this] (const juce::dsp::AudioBlock<SampleType>& part)
+	{
+		if constexpr (std::is_same<SampleType, double>::value)
+		{
+			processChannelGroups(doubleChannelGroups, part);
+		}
+		else
+		{
+			if (isDoubleState)
+				processChannelGroups(doubleChannelGroups, part);
+			else
+				processChannelGroups(floatChannelGroups, part);
+		}
+	};
+	
+	if (! isDynamic)
+	{
+		run(block);
+		return;
+	}
+	
+	// Band one takes the coefficients for its reduction at the start of every
+	// control interval. Glides and trajectories hand the block over in pieces,
+	// so chainPosition keeps count of how far into it this one starts.
+	const auto intervalLength = (size_t) (DynamicBand::controlInterval * oversamplingFactor);
+	const auto numSamples = block.getNumSamples();
+	
+	for (size_t start = 0; start < numSamples;)
+	{
+		const auto interval = chainPosition / intervalLength;
+		const auto length = juce::jmin(numSamples - start, (interval + 1) * intervalLength - chainPosition);
+		
+		setDynamicBandSection(DynamicBand::getCoefficients(*dynamicTable, dynamicBand.getReduction((int) interval)));
+		run(block.getSubBlock(start, length));
+		
+		start += length;
+		chainPosition += length;
+	}
+}
+
+void AwesomeEQAudioProcessor::setDynamicBandSection (const Coefficients& coefficients)
+{
+	// Only the precision in use; applyCoefficients() puts the static design back.
+	auto set = [&] (auto& channelGroups)
+	{
+		for (auto& chain : channelGroups)
+			chain.setSection(ChainPositions::Bands, coefficients);
+	};
+	
+	if (isDoubleState)
+		set(doubleChannelGroups);
+	else
+		set(floatChannelGroups);
+}
+
+void AwesomeEQAudioProcessor::updateDynamicBand()
+{
+	// Runs on the IIR chain only, with band one enabled and a table for the rate
+	// the chain is running at. Until the design thread has one, the band is static.
+	const bool dynamic = ! isLinearPhase
+					  && static_cast<DynamicsMode>(dynamicsModeValue->load()) != Dynamics_Off
+					  && appliedCoefficients.enabledBands[0]
+					  && dynamicTable != nullptr
+					  && dynamicTable->sampleRate == appliedCoefficients.sampleRate;
+	
+	chainPosition = 0;
+	
+	if (dynamic == isDynamic)
+		return;
+	
+	isDynamic = dynamic;
+	isDynamicPublished.store(dynamic, std::memory_order_relaxed);
+	
+	if (isDynamic)
+		dynamicBand.reset();
+	else
+		applyCoefficients(appliedCoefficients);
+}
+
+DynamicsSettings AwesomeEQAudioProcessor::getDynamicsSettings() const
+{
+	DynamicsSettings settings;
+	settings.thresholdInDecibels = dynamicsThresholdValue->load();
+	settings.ratio = dynamicsRatioValue->load();
+	settings.attackInMilliseconds = dynamicsAttackValue->load();
+	settings.releaseInMilliseconds = dynamicsReleaseValue->load();
+	return settings;
+}
+
+void AwesomeEQAudioProcessor::parameterChanged (const juce::String& parameterID, float newValue)
+{
+	// Band IDs are "Band1 ..." up to "Band8 ...", so the digit is enough and
+	// this stays allocation-free when automation arrives on the audio thread.
+	static_assert(maxNumBands <= 9, "Band parameter IDs are expected to have a single digit");
+	
+	// The detector settings are read by the audio thread as they are; only the
+	// dynamics mode itself changes what gets designed.
+	if (parameterID.startsWith("Band1 Dynamics "))
+		return;
+	
+	// The metering mode is too, but the design thread reports the latency that
+	// goes with it.
+	if (parameterID == "Metering")
+	{
+		designThread->requestDesign();
+		return;
+	}
+	
+	if (parameterID.startsWith("Band"))
+	{
+		const auto band = (int) (parameterID[4] - '1');
+		jassert(juce::isPositiveAndBelow(band, maxNumBands));
+		bandNeedsUpdate[(size_t) band] = true;
+	}
+	else if (parameterID.startsWith("Lowcut"))
+		lowCutNeedsUpdate = true;
+	else if (parameterID.startsWith("Highcut"))
+		highCutNeedsUpdate = true;
+	else if (parameterID == "Oversampling" && getSampleRate() > 0.0)
+		designSampleRate = getDesignSampleRate(newValue);
+	
+	// The kernel covers every stage of the curve at once, and also depends on its
+	// length. Nothing else, the band one dynamics mode included, changes it.
+	if (parameterID.startsWith("Lowcut") || parameterID.startsWith("Highcut") || parameterID == "Linear Phase Length"
+		|| (parameterID.startsWith("Band") && parameterID != "Band1 Dynamics"))
+		kernelNeedsUpdate = true;
+	
+	designThread->requestDesign();
+}
+
+void AwesomeEQAudioProcessor::designFilters()
+{
+	reportLatency();
+	designLinearPhaseKernel();
+	
+	const auto sampleRate = designSampleRate.load();
+	
+	if (sampleRate <= 0.0 || isRestoringState)
+		return;
+	
+	// A new sample rate invalidates every stage, not just the ones that moved.
+	const bool sampleRateChanged = latestDesign.sampleRate != sampleRate;
+	const bool lowCutChanged = lowCutNeedsUpdate.exchange(false) || sampleRateChanged;
+	const bool highCutChanged = highCutNeedsUpdate.exchange(false) || sampleRateChanged;
+	
+	std::array<bool, maxNumBands> bandChanged {};
+	bool anyBandChanged = false;
+	
+	for (size_t i = 0; i < bandChanged.size(); ++i)
+	{
+		bandChanged[i] = bandNeedsUpdate[i].exchange(false) || sampleRateChanged;
+		anyBandChanged = anyBandChanged || bandChanged[i];
+	}
+	
+	if (! anyBandChanged && ! lowCutChanged && ! highCutChanged)
+		return;
+	
+	auto channelSettings = channelParameters.load();
+	const bool layoutChanged = haveDifferentLayouts(channelSettings, latestSettings);
+	
+	for (size_t i = 0; i < bandChanged.size(); ++i)
+	{
+		if (! bandChanged[i])
+			continue;
+		
+		const auto& band = channelSettings.bands[i];
+		latestDesign.bands[i] = band.enabled ? coefficientCache->getBandFilter(band, sampleRate) : Coefficients { 1.0, 0.0, 0.0, 1.0, 0.0, 0.0 };
+		latestDesign.enabledBands[i] = band.enabled;
+	}
+	
+	// The meter's band filters run at the host rate, whatever the chain's.
+	if (anyBandChanged)
+	{
+		LevelMeter::makeBandFilters(channelSettings, kernelSampleRate.load(), meterBandFilters.getBackBuffer());
+		meterBandFilters.publish();
+	}
+	
+	// Band one's range of reductions, whenever the band itself moves.
+	if (bandChanged[0] && channelSettings.bands[0].enabled && static_cast<DynamicsMode>(dynamicsModeValue->load()) != Dynamics_Off)
+	{
+		DynamicBand::makeTable(channelSettings.bands[0], sampleRate, dynamicTables.getBackBuffer());
+		dynamicTables.publish();
+	}
+	
+	if (lowCutChanged)
+	{
+		latestDesign.lowCut = coefficientCache->getLowCutFilter(channelSettings, sampleRate);
+		latestDesign.lowCutSlope = channelSettings.lowCutSlope;
+	}
+	
+	if (highCutChanged)
+	{
+		latestDesign.highCut = coefficientCache->getHighCutFilter(channelSettings, sampleRate);
+		latestDesign.highCutSlope = channelSettings.highCutSlope;
+	}
+	
+	latestDesign.sampleRate = sampleRate;
+	latestDesign.isNeutral = isNeutral(channelSettings);
+	
+	// The steps on the way come through the cache too, so a sweep the host
+	// repeats, or that only moves one stage, is mostly hits. A new rate, slope,
+	// band type or enabled band can't be swept through, so it arrives as a single step.
+	const auto numSteps = sampleRateChanged || layoutChanged ? 1 : getNumAutomationSteps();
+	auto& trajectory = designedCoefficients.getBackBuffer();
+	trajectory.numSteps = numSteps;
+	
+	for (int step = 1; step < numSteps; ++step)
+	{
+		const auto proportion = (float) step / (float) numSteps;
+		trajectory.steps[(size_t) step - 1] = coefficientCache->makeChainCoefficients(interpolateSettings(latestSettings, channelSettings, proportion), sampleRate);
+	}
+	
+	trajectory.steps[(size_t) numSteps - 1] = latestDesign;
+	latestSettings = channelSettings;
+	designedCoefficients.publish();
+	metrics.recordDesign();
+}
+
+void AwesomeEQAudioProcessor::designLinearPhaseKernel()
+{
+	const auto sampleRate = kernelSampleRate.load();
+	
+	// In minimum-phase mode the flag stays set, so switching over designs for
+	// the current curve straight away.
+	if (sampleRate <= 0.0 || isRestoringState || getPhaseMode() != Phase_Linear)
+		return;
+	
+	const juce::ScopedLock sl (linearPhaseLock);
+	
+	if (! isLinearPhaseReady)
+	{
+		prepareLinearPhase();
+		return;
+	}
+	
+	if (! kernelNeedsUpdate.exchange(false) && latestKernel.sampleRate == sampleRate)
+		return;
+	
+	const auto length = getKernelLength(static_cast<KernelLength>(kernelLengthValue->load()));
+	
+	kernelDesigner.design(channelParameters.load(), sampleRate, length, latestKernel);
+	linearPhaseConvolver.publishKernel(latestKernel);
+	metrics.recordKernelDesign();
+}
+
+int AwesomeEQAudioProcessor::getNumAutomationSteps() const
+{
+	// Enough steps for the largest block the host will send, at the chosen resolution.
+	const auto automationResolution = static_cast<AutomationResolution>(automationResolutionValue->load());
+	const auto interval = getAutomationInterval(automationResolution);
+	
+	if (interval == 0)
+		return 1;
+	
+	return juce::jlimit(1, DesignTrajectory::maxNumSteps, (maxBlockSize.load() + interval - 1) / interval);
+}
+
+void AwesomeEQAudioProcessor::updateFilters()
+{
+	if (dynamicTables.pull())
+		dynamicTable = &dynamicTables.read();
+	
+	if (meterBandFilters.pull())
+		levelMeter.setBandFilters(meterBandFilters.read());
+	
+	if (! designedCoefficients.pull())
+		return;
+	
+	// Sets designed for a previous sample rate can still be in flight after
+	// prepareToPlay(). A set designed for another multiple of the current rate
+	// is how an oversampling change arrives: the chain switches along with it.
+	const auto& trajectory = designedCoefficients.read();
+	const auto& chainCoefficients = trajectory.getFinal();
+	pendingTrajectory = nullptr;
+	const auto factor = chainCoefficients.sampleRate / getSampleRate();
+	
+	if (factor != 1.0 && factor != 2.0 && factor != 4.0)
+		return;
+	
+	if ((int) factor != oversamplingFactor)
+		setOversamplingFactor((int) factor);
+	
+	// A slope change alters the section layout, which can't be blended, so it always jumps.
+	const auto smoothingMode = static_cast<SmoothingMode>(smoothingValue->load());
+	
+	const bool sameLayout = chainCoefficients.lowCutSlope == appliedCoefficients.lowCutSlope
+						 && chainCoefficients.highCutSlope == appliedCoefficients.highCutSlope
+						 && chainCoefficients.sampleRate == appliedCoefficients.sampleRate;
+	
+	if ((smoothingMode != Smoothing_Off || trajectory.numSteps > 1) && sameLayout)
+	{
+		targetCoefficients = chainCoefficients;
+		isRamping = true;
+		
+		if (trajectory.numSteps > 1)
+			pendingTrajectory = &trajectory;
+	}
+	else
+	{
+		applyCoefficients(chainCoefficients);
+		isRamping = false;
+	}
+}
+
+template <typename StateType>
+static void updateCutFilter (BiquadCascade<StateType>& chain, int firstSection, const CutCoefficients& cutCoefficients, Slope slope)
+{
+	// Only the sections the slope needs are enabled; the rest are skipped by the cascade.
+	const auto numSections = getNumCutSections(slope);
+	
+	for (int i = 0; i < (int) cutCoefficients.size(); ++i)
+	{
+		chain.setSection(firstSection + i, cutCoefficients[(size_t) i]);
+		chain.setSectionEnabled(firstSection + i, i < numSections);
+	}
+}
+
+void AwesomeEQAudioProcessor::applyCoefficients (const ChainCoefficients& chainCoefficients)
+{
+	appliedCoefficients = chainCoefficients;
+	
+	auto apply = [&] (auto& channelGroups)
+	{
+		for (auto& chain : channelGroups)
+		{
+			updateCutFilter(chain, ChainPositions::Lowcut, chainCoefficients.lowCut, chainCoefficients.lowCutSlope);
+			
+			for (int i = 0; i < maxNumBands; ++i)
+			{
+				chain.setSection(ChainPositions::Bands + i, chainCoefficients.bands[(size_t) i]);
+				chain.setSectionEnabled(ChainPositions::Bands + i, chainCoefficients.enabledBands[(size_t) i]);
+			}
+			
+			updateCutFilter(chain, ChainPositions::HighCut, chainCoefficients.highCut, chainCoefficients.highCutSlope);
+		}
+	};
+	
+	// Only the precision in use is kept current; the other catches up when switched to.
+	if (isDoubleState)
+		apply(doubleChannelGroups);
+	else
+		apply(floatChannelGroups);
+}
+
+//==============================================================================
+bool AwesomeEQAudioProcessor::hasEditor() const
+{
+    return true; // (change this to false if you choose to not supply an editor)
+}
+
+juce::AudioProcessorEditor* AwesomeEQAudioProcessor::createEditor()
+{
+	return new AwesomeEQAudioProcessorEditor(*this);
+}
+
+bool AwesomeEQAudioProcessor::attachAnalyzer()
+{
+	// The FIFOs are allocated on first use. processBlock() only touches them once
+	// attached, and that can't happen before this returns.
+	preAnalyzerFifo.allocate();
+	postAnalyzerFifo.allocate();
+	
+	bool expected = false;
+	return analyzerAttached.compare_exchange_strong(expected, true);
+}
+
+//==============================================================================
+// Binary state layout: magic, version byte, parameter count, then one
+// (parameter ID, value) pair per parameter. Values are stored by ID rather than
+// by position so that states stay loadable when parameters are added.
+static constexpr int stateMagic = 0x53514541; // "AEQS"
+static constexpr int stateVersion = 1;
+
+void AwesomeEQAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
+{
+	juce::Array<juce::RangedAudioParameter*> rangedParameters;
+	
+	for (auto* parameter : getParameters())
+		if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+			rangedParameters.add(ranged);
+	
+	juce::MemoryOutputStream stream (destData, false);
+	stream.writeInt(stateMagic);
+	stream.writeByte((char) stateVersion);
+	stream.writeCompressedInt(rangedParameters.size());
+	
+	for (auto* parameter : rangedParameters)
+	{
+		stream.writeString(parameter->paramID);
+		stream.writeFloat(parameter->convertFrom0to1(parameter->getValue()));
+	}
+}
+
+// Before the band array there was a single peak, "Peak Freq" and so on; it's
+// band 1 now, which is enabled and a bell by default, so old sessions sound the same.
+static juce::String upgradeParameterID (const juce::String& parameterID)
+{
+	if (parameterID.startsWith("Peak "))
+		return "Band1 " + parameterID.fromFirstOccurrenceOf(" ", false, false);
+	
+	return parameterID;
+}
+
+void AwesomeEQAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
+{
+	isRestoringState = true;
+	
+	// Anything that isn't our binary format is tried as an XML parameter tree.
+	if (! readBinaryState(data, sizeInBytes))
+		if (auto xml = getXmlFromBinary(data, sizeInBytes))
+			if (xml->hasTagName(parameters.state.getType()))
+			{
+				for (auto* parameter : xml->getChildIterator())
+					if (parameter->hasAttribute("id"))
+						parameter->setAttribute("id", upgradeParameterID(parameter->getStringAttribute("id")));
+				
+				parameters.replaceState(juce::ValueTree::fromXml(*xml));
+			}
+	
+	isRestoringState = false;
+	designThread->requestDesign();
+}
+
+bool AwesomeEQAudioProcessor::readBinaryState (const void* data, int sizeInBytes)
+{
+	if (data == nullptr || sizeInBytes < 5)
+		return false;
+	
+	juce::MemoryInputStream stream (data, (size_t) sizeInBytes, false);
+	
+	if (stream.readInt() != stateMagic || (int) (juce::uint8) stream.readByte() > stateVersion)
+		return false;
+	
+	const auto numParameters = stream.readCompressedInt();
+	
+	for (int i = 0; i < numParameters && ! stream.isExhausted(); ++i)
+	{
+		const auto parameterID = stream.readString();
+		const auto value = stream.readFloat();
+		
+		if (auto* parameter = parameters.getParameter(upgradeParameterID(parameterID)))
+			parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+	}
+	
+	return true;
+}
+
+const BandParameterIDs& getBandParameterIDs (int band)
+{
+	static const auto table = []
+	{
+		std::array<BandParameterIDs, maxNumBands> ids;
+		
+		for (int i = 0; i < maxNumBands; ++i)
+		{
+			const auto prefix = "Band" + juce::String(i + 1) + " ";
+			auto& bandIDs = ids[(size_t) i];
+			bandIDs.enabled = prefix + "Enabled";
+			bandIDs.type = prefix + "Type";
+			bandIDs.freq = prefix + "Freq";
+			bandIDs.gain = prefix + "Gain";
+			bandIDs.quality = prefix + "Quality";
+		}
+		
+		return ids;
+	}();
+	
+	jassert(juce::isPositiveAndBelow(band, maxNumBands));
+	return table[(size_t) band];
+}
+
+ChannelSettings getChannelSettings (const juce::AudioProcessorValueTreeState& parameters)
+{
+	return ChannelParameters(parameters).load();
+}
+
+ChannelParameters::ChannelParameters (const juce::AudioProcessorValueTreeState& parameters)
+	: lowCutFreq(parameters.getRawParameterValue("Lowcut Freq")),
+	  highCutFreq(parameters.getRawParameterValue("Highcut Freq")),
+	  lowCutSlope(parameters.getRawParameterValue("Lowcut Slope")),
+	  highCutSlope(parameters.getRawParameterValue("Highcut Slope"))
+{
+	for (int i = 0; i < maxNumBands; ++i)
+	{
+		const auto& ids = getBandParameterIDs(i);
+		
+		bands[(size_t) i] = { parameters.getRawParameterValue(ids.enabled), parameters.getRawParameterValue(ids.type),
+							  parameters.getRawParameterValue(ids.freq), parameters.getRawParameterValue(ids.gain),
+							  parameters.getRawParameterValue(ids.quality) };
+	}
+}
+
+ChannelSettings ChannelParameters::load() const noexcept
+{
+	ChannelSettings settings;
+	
+	settings.lowCutFreq = lowCutFreq->load();
+	settings.highCutFreq = highCutFreq->load();
+	settings.lowCutSlope = static_cast<Slope>(lowCutSlope->load());
+	settings.highCutSlope = static_cast<Slope>(highCutSlope->load());
+	
+	for (size_t i = 0; i < bands.size(); ++i)
+	{
+		auto& band = settings.bands[i];
+		
+		band.enabled = bands[i].enabled->load() > 0.5f;
+		band.type = static_cast<BandType>(bands[i].type->load());
+		band.freq = bands[i].freq->load();
+		band.gainInDecibels = bands[i].gain->load();
+		band.quality = bands[i].quality->load();
+	}
+	
+	return settings;
+}
+
+int getSmoothingInterval (SmoothingMode mode)
+{
+	switch (mode)
+	{
+		case Smoothing_64:			return 64;
+		case Smoothing_16:			return 16;
+		case Smoothing_PerSample:	return 1;
+		case Smoothing_Off:			break;
+	}
+	
+	return 0;
+}
+
+int getAutomationInterval (AutomationResolution resolution)
+{
+	switch (resolution)
+	{
+		case Automation_128:	return 128;
+		case Automation_32:		return 32;
+		case Automation_Block:	break;
+	}
+	
+	return 0;
+}
+
+int getKernelLength (KernelLength length)
+{
+	switch (length)
+	{
+		case KernelLength_4096:	return 4096;
+		case KernelLength_8192:	return 8192;
+		case KernelLength_2048:	break;
+	}
+	
+	return 2048;
+}
+
+int getOversamplingFactor (OversamplingMode mode)
+{
+	switch (mode)
+	{
+		case Oversampling_2x:	return 2;
+		case Oversampling_4x:	return 4;
+		case Oversampling_Off:	break;
+	}
+	
+	return 1;
+}
+
+juce::AudioProcessorValueTreeState::ParameterLayout AwesomeEQAudioProcessor::createParameterLayout()
+{
+	juce::AudioProcessorValueTreeState::ParameterLayout layout;
+	layout.add(std::make_unique<juce::AudioParameterFloat>("Lowcut Freq", "Lowcut Freq", juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f), 20.f ));
+	
+	layout.add(std::make_unique<juce::AudioParameterFloat>("Highcut Freq", "Highcut Freq", juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f), 20000.f ));
+	
+	// Band 1 takes over from the old single peak; the rest start disabled, spread
+	// across the spectrum, with a shelf at either end.
+	const std::array<float, maxNumBands> defaultFrequencies { 750.f, 80.f, 200.f, 400.f, 1500.f, 3000.f, 6000.f, 12000.f };
+	const std::array<BandType, maxNumBands> defaultTypes { Band_Bell, Band_LowShelf, Band_Bell, Band_Bell, Band_Bell, Band_Bell, Band_Bell, Band_HighShelf };
+	
+	for (int i = 0; i < maxNumBands; ++i)
+	{
+		const auto& ids = getBandParameterIDs(i);
+		
+		layout.add(std::make_unique<juce::AudioParameterBool>(ids.enabled, ids.enabled, i == 0));
+		
+		layout.add(std::make_unique<juce::AudioParameterChoice>(ids.type, ids.type, juce::StringArray { "Bell", "Low Shelf", "High Shelf", "Notch" }, (int) defaultTypes[(size_t) i]));
+		
+		layout.add(std::make_unique<juce::AudioParameterFloat>(ids.freq, ids.freq, juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f), defaultFrequencies[(size_t) i] ));
+		
+		layout.add(std::make_unique<juce::AudioParameterFloat>(ids.gain, ids.gain, juce::NormalisableRange<float>(-36.f, 36.f, 0.5f, 1.f), 0.0f ));
+		
+		layout.add(std::make_unique<juce::AudioParameterFloat>(ids.quality, ids.quality, juce::NormalisableRange<float>(0.1f, 10.f, 0.05f, 1.f), 1.f ));
+	}
+	
+	// Band one can also be dynamic, keyed from the input or the sidechain.
+	layout.add(std::make_unique<juce::AudioParameterChoice>("Band1 Dynamics", "Band1 Dynamics", juce::StringArray { "Off", "Input", "Sidechain" }, 0));
+	layout.add(std::make_unique<juce::AudioParameterFloat>("Band1 Dynamics Threshold", "Band1 Dynamics Threshold", juce::NormalisableRange<float>(-60.f, 0.f, 0.5f, 1.f), -24.f ));
+	layout.add(std::make_unique<juce::AudioParameterFloat>("Band1 Dynamics Ratio", "Band1 Dynamics Ratio", juce::NormalisableRange<float>(1.f, 10.f, 0.1f, 0.5f), 2.f ));
+	layout.add(std::make_unique<juce::AudioParameterFloat>("Band1 Dynamics Attack", "Band1 Dynamics Attack", juce::NormalisableRange<float>(0.1f, 100.f, 0.1f, 0.3f), 5.f ));
+	layout.add(std::make_unique<juce::AudioParameterFloat>("Band1 Dynamics Release", "Band1 Dynamics Release", juce::NormalisableRange<float>(5.f, 1000.f, 1.f, 0.3f), 100.f ));
+	
+	
+	
+	juce::StringArray stringArray;
+	
+	for (int i = 0; i < 4; i++)
+	{
+		juce::String str;
+		str << (12 + i * 12);
+		str << " db/Oct";
+		
+		stringArray.add(str);
+	}
+	
+	layout.add (std::make_unique<juce::AudioParameterChoice>("Lowcut Slope", "Lowcut Slope", stringArray, 0));
+	layout.add (std::make_unique<juce::AudioParameterChoice>("Highcut Slope", "Highcut Slope", stringArray, 0));
+	
+	layout.add (std::make_unique<juce::AudioParameterChoice>("Smoothing", "Smoothing", juce::StringArray { "Off", "64 Samples", "16 Samples", "Per Sample" }, 0));
+	layout.add (std::make_unique<juce::AudioParameterChoice>("Automation Resolution", "Automation Resolution", juce::StringArray { "Block", "128 Samples", "32 Samples" }, 0));
+	layout.add (std::make_unique<juce::AudioParameterChoice>("Oversampling", "Oversampling", juce::StringArray { "Off", "2x", "4x" }, 0));
+	layout.add (std::make_unique<juce::AudioParameterChoice>("Filter Precision", "Filter Precision", juce::StringArray { "Float", "Double" }, 0));
+	layout.add (std::make_unique<juce::AudioParameterChoice>("Phase", "Phase", juce::StringArray { "Minimum", "Linear" }, 0));
+	layout.add (std::make_unique<juce::AudioParameterChoice>("Linear Phase Length", "Linear Phase Length", juce::StringArray { "2048 Taps", "4096 Taps", "8192 Taps" }, 1));
+	layout.add (std::make_unique<juce::AudioParameterChoice>("Metering", "Metering", juce::StringArray { "Off", "On", "Analysis Only" }, 0));
+	
+	return layout;
+}
+
+//==============================================================================
+// This creates new instances of the plugin..
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
+{
+    return new AwesomeEQAudioProcessor();
+}
@@ -1,94 +1,359 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin processor.
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-
-enum Slope
-{
-	Slope_12,
-	Slope_24,
-	Slope_36,
-	Slope_48
-};
-
-struct ChannelSettings
-{
-	float peakFreq { 0 }, peakGainInDecibels { 0 }, peakQuality {1.f};
-	float lowCutFreq { 0 }, highCutFreq { 0 };
-	Slope lowCutSlope { Slope::Slope_12 }, highCutSlope { Slope::Slope_12 };
-};
-
-ChannelSettings getChannelSettings(juce::AudioProcessorValueTreeState& parameters);
-//==============================================================================
-/**
-*/
-class AwesomeEQAudioProcessor  : public juce::AudioProcessor
-{
-public:
-    //==============================================================================
-    AwesomeEQAudioProcessor();
-    ~AwesomeEQAudioProcessor() override;
-
-    //==============================================================================
-    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
-    void releaseResources() override;
-
-   #ifndef JucePlugin_PreferredChannelConfigurations
-    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
-   #endif
-
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
-
-    //==============================================================================
-    juce::AudioProcessorEditor* createEditor() override;
-    bool hasEditor() const override;
-
-    //==============================================================================
-    const juce::String getName() const override;
-
-    bool acceptsMidi() const override;
-    bool producesMidi() const override;
-    bool isMidiEffect() const override;
-    double getTailLengthSeconds() const override;
-
-    //==============================================================================
-    int getNumPrograms() override;
-    int getCurrentProgram() override;
-    void setCurrentProgram (int index) override;
-    const juce::String getProgramName (int index) override;
-    void changeProgramName (int index, const juce::String& newName) override;
-
-    //==============================================================================
-    void getStateInformation (juce::MemoryBlock& destData) override;
-    void setStateInformation (const void* data, int sizeInBytes) override;
-	
-	// Parameter Connection to DSP
-	static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
-	juce::AudioProcessorValueTreeState parameters {*this, nullptr, "Parameters", createParameterLayout()};
-
-private:
-	using Filter = juce::dsp::IIR::Filter<float>;
-	
-	using CutFilter = juce::dsp::ProcessorChain<Filter, Filter, Filter, Filter>;
-	
-	using MonoChain = juce::dsp::ProcessorChain<CutFilter, Filter, CutFilter>;
-	
-	MonoChain leftChannel, rightChannel;
-	
-	enum ChainPositions
-	{
-		Lowcut,
-		Peak,
-		HighCut
-	};
-	
-    //==============================================================================
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AwesomeEQAudioProcessor)
-};
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin processor.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "AnalyzerFifo.h"
+#include "BiquadCascade.h"
+#include "ChainDesign.h"
+#include "CoefficientCache.h"
+#include "DynamicBand.h"
+#include "FilterDesignThread.h"
+#include "LevelMeter.h"
+#include "LinearPhaseConvolver.h"
+#include "ProcessorMetrics.h"
+#include "TripleBuffer.h"
+
+ChannelSettings getChannelSettings(const juce::AudioProcessorValueTreeState& parameters);
+
+// The raw values of every parameter the chain is designed from, looked up by ID
+// once, so reading the settings afterwards is only a handful of atomic loads.
+class ChannelParameters
+{
+public:
+	explicit ChannelParameters(const juce::AudioProcessorValueTreeState& parameters);
+	
+	ChannelSettings load() const noexcept;
+	
+private:
+	struct BandValues
+	{
+		std::atomic<float>* enabled;
+		std::atomic<float>* type;
+		std::atomic<float>* freq;
+		std::atomic<float>* gain;
+		std::atomic<float>* quality;
+	};
+	
+	std::atomic<float>* lowCutFreq;
+	std::atomic<float>* highCutFreq;
+	std::atomic<float>* lowCutSlope;
+	std::atomic<float>* highCutSlope;
+	std::array<BandValues, maxNumBands> bands;
+};
+
+// The parameter IDs of one band, e.g. "Band1 Freq". They're built once, so the
+// design thread can look parameters up by them without allocating.
+struct BandParameterIDs
+{
+	juce::String enabled, type, freq, gain, quality;
+};
+
+const BandParameterIDs& getBandParameterIDs(int band);
+
+// How often the coefficients are stepped while gliding towards a new design.
+enum SmoothingMode
+{
+	Smoothing_Off,
+	Smoothing_64,
+	Smoothing_16,
+	Smoothing_PerSample
+};
+
+int getSmoothingInterval(SmoothingMode mode);
+
+// How finely a block is split to follow automation. Each split gets a design
+// of its own, for the parameter values part of the way through the move.
+enum AutomationResolution
+{
+	Automation_Block,
+	Automation_128,
+	Automation_32
+};
+
+int getAutomationInterval(AutomationResolution resolution);
+
+// Runs the chain at a multiple of the host rate, so peaks and cuts near
+// Nyquist aren't cramped by the bilinear transform.
+enum OversamplingMode
+{
+	Oversampling_Off,
+	Oversampling_2x,
+	Oversampling_4x
+};
+
+int getOversamplingFactor(OversamplingMode mode);
+
+enum PhaseMode
+{
+	Phase_Minimum,
+	Phase_Linear
+};
+
+// Longer linear-phase kernels resolve steeper, lower cuts at the price of latency.
+enum KernelLength
+{
+	KernelLength_2048,
+	KernelLength_4096,
+	KernelLength_8192
+};
+
+int getKernelLength(KernelLength length);
+
+// The precision of the IIR state for float host buffers. Double buffers always
+// run double state, so "Double" on a float host is the mixed-precision path.
+enum FilterPrecision
+{
+	Precision_Float,
+	Precision_Double
+};
+
+// Level and band energy readings on the way through. Analysis only measures the
+// input and passes it on untouched, without running the chain at all.
+enum MeteringMode
+{
+	Metering_Off,
+	Metering_On,
+	Metering_AnalysisOnly
+};
+//==============================================================================
+/**
+*/
+class AwesomeEQAudioProcessor  : public juce::AudioProcessor,
+                                 private juce::AudioProcessorValueTreeState::Listener,
+                                 private FilterDesignThread::Client
+{
+public:
+    //==============================================================================
+    AwesomeEQAudioProcessor();
+    ~AwesomeEQAudioProcessor() override;
+
+    //==============================================================================
+    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
+    void releaseResources() override;
+
+   #ifndef JucePlugin_PreferredChannelConfigurations
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
+   #endif
+
+    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override;
+
+    //==============================================================================
+    juce::AudioProcessorEditor* createEditor() override;
+    bool hasEditor() const override;
+
+    //==============================================================================
+    const juce::String getName() const override;
+
+    bool acceptsMidi() const override;
+    bool producesMidi() const override;
+    bool isMidiEffect() const override;
+    double getTailLengthSeconds() const override;
+
+    //==============================================================================
+    int getNumPrograms() override;
+    int getCurrentProgram() override;
+    void setCurrentProgram (int index) override;
+    const juce::String getProgramName (int index) override;
+    void changeProgramName (int index, const juce::String& newName) override;
+
+    //==============================================================================
+    void getStateInformation (juce::MemoryBlock& destData) override;
+    void setStateInformation (const void* data, int sizeInBytes) override;
+	
+	// Parameter Connection to DSP
+	static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
+	juce::AudioProcessorValueTreeState parameters {*this, nullptr, "Parameters", createParameterLayout()};
+	
+	// Hit rate and footprint of the design cache, which is shared by every instance in the process.
+	CoefficientCache::Statistics getCoefficientCacheStatistics() const	{ return coefficientCache->getStatistics(); }
+	
+	// The spectrum analyzer reads these; only one analyzer may be attached at a
+	// time, and processBlock() skips the copies while none is. Message thread only.
+	bool attachAnalyzer();
+	void detachAnalyzer()							{ analyzerAttached = false; }
+	AnalyzerFifo& getPreAnalyzerFifo()				{ return preAnalyzerFifo; }
+	AnalyzerFifo& getPostAnalyzerFifo()				{ return postAnalyzerFifo; }
+	
+	// Timing, redesign and section counts since the last prepareToPlay(). Safe
+	// to call from any thread; the audio thread never waits for a reader.
+	ProcessorMetrics::Snapshot getMetrics() const	{ return metrics.getSnapshot(); }
+	
+	// The meter's latest readings, while metering is on. Safe to call from any
+	// thread, as is resetMeters(), which takes effect from the next block.
+	LevelMeter::Readings getMeterReadings() const	{ return levelMeter.getReadings(); }
+	void resetMeters()								{ levelMeter.requestReset(); }
+	
+	// Whether band one ran as a dynamic band in the last block; until the design
+	// thread has its table for the current rate, it stays static. Any thread.
+	bool isBandOneDynamic() const					{ return isDynamicPublished.load(std::memory_order_relaxed); }
+
+private:
+	// Looked up once here, so neither the audio thread nor the design thread
+	// searches the parameter tree by ID.
+	const ChannelParameters channelParameters { parameters };
+	std::atomic<float>* const smoothingValue { parameters.getRawParameterValue("Smoothing") };
+	std::atomic<float>* const automationResolutionValue { parameters.getRawParameterValue("Automation Resolution") };
+	std::atomic<float>* const oversamplingValue { parameters.getRawParameterValue("Oversampling") };
+	std::atomic<float>* const filterPrecisionValue { parameters.getRawParameterValue("Filter Precision") };
+	std::atomic<float>* const phaseValue { parameters.getRawParameterValue("Phase") };
+	std::atomic<float>* const kernelLengthValue { parameters.getRawParameterValue("Linear Phase Length") };
+	std::atomic<float>* const dynamicsModeValue { parameters.getRawParameterValue("Band1 Dynamics") };
+	std::atomic<float>* const dynamicsThresholdValue { parameters.getRawParameterValue("Band1 Dynamics Threshold") };
+	std::atomic<float>* const dynamicsRatioValue { parameters.getRawParameterValue("Band1 Dynamics Ratio") };
+	std::atomic<float>* const dynamicsAttackValue { parameters.getRawParameterValue("Band1 Dynamics Attack") };
+	std::atomic<float>* const dynamicsReleaseValue { parameters.getRawParameterValue("Band1 Dynamics Release") };
+	std::atomic<float>* const meteringValue { parameters.getRawParameterValue("Metering") };
+	
+	// All channels share coefficients, so they run side by side in the SIMD lanes
+	// of a cascade; one cascade per group of BiquadCascade::maxNumChannels channels.
+	// Both precisions are prepared, so switching between them never allocates.
+	std::vector<BiquadCascade<float>> floatChannelGroups;
+	std::vector<BiquadCascade<double>> doubleChannelGroups;
+	bool isDoubleState { false };
+	
+	// Set by parameterChanged() and consumed by designFilters() on the design
+	// thread, so a stage is only redesigned when one of its parameters moved.
+	std::atomic<bool> lowCutNeedsUpdate { true }, highCutNeedsUpdate { true };
+	std::array<std::atomic<bool>, maxNumBands> bandNeedsUpdate;
+	std::atomic<double> designSampleRate { 0.0 };
+	std::atomic<int> maxBlockSize { 0 };
+	
+	// While a state is being restored the design thread leaves the dirty flags
+	// alone, so a whole preset costs one redesign instead of one per parameter.
+	std::atomic<bool> isRestoringState { false };
+	
+	// Only touched by the design thread. The settings are the ones the last
+	// published design was made from, where the next trajectory starts. The
+	// trajectory itself is built in place in the triple buffer's back slot.
+	ChainCoefficients latestDesign;
+	ChannelSettings latestSettings;
+	
+	TripleBuffer<DesignTrajectory> designedCoefficients;
+	juce::SharedResourcePointer<FilterDesignThread> designThread;
+	juce::SharedResourcePointer<CoefficientCache> coefficientCache;
+	
+	void parameterChanged(const juce::String& parameterID, float newValue) override;
+	void designFilters() override;
+	
+	bool readBinaryState(const void* data, int sizeInBytes);
+	
+	// Audio thread state: what the chains are running right now, and the design
+	// they are gliding towards when smoothing is enabled.
+	// A pending trajectory lives in the triple buffer's read slot, which stays
+	// put until the next pull.
+	ChainCoefficients appliedCoefficients, targetCoefficients;
+	bool isRamping { false };
+	const DesignTrajectory* pendingTrajectory { nullptr };
+	
+	int getNumAutomationSteps() const;
+	
+	AnalyzerFifo preAnalyzerFifo, postAnalyzerFifo;
+	std::atomic<bool> analyzerAttached { false };
+	
+	// One oversampler per factor, all prepared up front, so switching between
+	// them never allocates on the audio thread. Only the host's precision is built.
+	std::array<std::unique_ptr<juce::dsp::Oversampling<float>>, 2> floatOversamplers;
+	std::array<std::unique_ptr<juce::dsp::Oversampling<double>>, 2> doubleOversamplers;
+	int oversamplingFactor { 1 };
+	
+	double getDesignSampleRate(float oversamplingParameter) const;
+	void setOversamplingFactor(int factor);
+	int getOversamplingLatency() const;
+	
+	template <typename SampleType>
+	juce::dsp::Oversampling<SampleType>* getOversampler() const;
+	
+	// Linear-phase mode replaces the whole IIR path, oversampling included.
+	// The kernel is redesigned on the design thread whenever the curve moves.
+	// Nothing for it is allocated or designed until the mode is first chosen;
+	// the audio thread stays on the IIR chain until the convolver is ready.
+	LinearPhaseConvolver linearPhaseConvolver;
+	std::atomic<bool> kernelNeedsUpdate { true }, isLinearPhaseReady { false };
+	std::atomic<double> kernelSampleRate { 0.0 };
+	int numLinearPhaseChannels { 0 };
+	bool isLinearPhase { false };
+	
+	// Held by prepareToPlay() and the design thread while either sets up or
+	// designs for the convolver; never by the audio thread.
+	juce::CriticalSection linearPhaseLock;
+	LinearPhaseKernelDesigner kernelDesigner;
+	LinearPhaseKernel latestKernel;
+	
+	PhaseMode getPhaseMode() const;
+	void designLinearPhaseKernel();
+	void prepareLinearPhase();
+	
+	// The audio thread works out the chain's latency as the chain changes, but
+	// the host is told from the design thread: setLatencySamples() calls back
+	// into the host, which can block or post a message.
+	std::atomic<int> chainLatency { 0 };
+	
+	void updateLatency();
+	void reportLatency();
+	
+	void updateFilters();
+	void applyCoefficients(const ChainCoefficients& chainCoefficients);
+	void resetChains();
+	
+	// Neutral bands pass the audio straight through, and once the input has
+	// been silent for longer than the chain rings the filters sleep until it
+	// isn't. Silence is anything below -120 dBFS.
+	static constexpr double silenceThreshold = 1.0e-6;
+	bool isBypassed { false }, isSleeping { false };
+	int silenceCountdown { -1 };
+	
+	void wakeUp();
+	
+	ProcessorMetrics metrics;
+	void recordMetrics(bool chainRan, juce::int64 startTicks, int numSamples);
+	
+	// Band one as a dynamic band. Its tables come from the design thread; the
+	// envelope, and band one's section every control interval, from the audio
+	// thread. While isDynamic, the section holds whatever the last interval set.
+	DynamicBand dynamicBand;
+	TripleBuffer<DynamicBand::Table> dynamicTables;
+	const DynamicBand::Table* dynamicTable { nullptr };
+	bool isDynamic { false };
+	std::atomic<bool> isDynamicPublished { false };
+	size_t chainPosition { 0 };
+	
+	void updateDynamicBand();
+	void setDynamicBandSection(const Coefficients& coefficients);
+	DynamicsSettings getDynamicsSettings() const;
+	
+	// The meter's band filters come from the design thread like everything else.
+	// While isAnalysisOnly the chain is skipped, and the design thread reports
+	// no latency for it.
+	LevelMeter levelMeter;
+	TripleBuffer<LevelMeter::BandFilters> meterBandFilters;
+	bool isAnalysisOnly { false };
+	
+	MeteringMode getMeteringMode() const;
+	
+	template <typename SampleType>
+	void process(juce::AudioBuffer<SampleType>& buffer, const juce::AudioBuffer<SampleType>& sidechain);
+	
+	template <typename SampleType>
+	void processFilters(juce::dsp::AudioBlock<SampleType>& block);
+	
+	template <typename SampleType>
+	void processChain(const juce::dsp::AudioBlock<SampleType>& block);
+	
+	template <typename SampleType>
+	void glideTo(const juce::dsp::AudioBlock<SampleType>& block, const ChainCoefficients& target, SmoothingMode smoothingMode);
+	
+	template <typename SampleType>
+	void processTrajectory(const juce::dsp::AudioBlock<SampleType>& block, const DesignTrajectory& trajectory, SmoothingMode smoothingMode);
+	
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AwesomeEQAudioProcessor)
+};
@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+
+    ProcessorMetrics.cpp
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#include "ProcessorMetrics.h"
+
+//==============================================================================
+void ProcessorMetrics::reset() noexcept
+{
+	for (auto& bucket : durationHistogram)
+		bucket = 0;
+	
+	for (auto* counter : { &numBlocks, &numBlocksOverHalfDeadline, &numOverruns, &numDenormalBlocks, &numDesigns, &numKernelDesigns })
+		*counter = 0;
+	
+	lastDeadlineUsed = averageDeadlineUsed = peakDeadlineUsed = 0.0;
+	numActiveSections = numChains = 0;
+}
+
+void ProcessorMetrics::recordBlock (juce::int64 elapsedTicks, int numSamples, double sampleRate) noexcept
+{
+	const auto seconds = juce::Time::highResolutionTicksToSeconds(elapsedTicks);
+	const auto microseconds = (juce::uint32) juce::jlimit(0.0, (double) std::numeric_limits<juce::uint32>::max(), seconds * 1.0e6);
+	const auto bucket = microseconds == 0 ? 0 : juce::jmin(numDurationBuckets - 1, juce::findHighestSetBit(microseconds) + 1);
+	increment(durationHistogram[(size_t) bucket]);
+	
+	const auto blocks = numBlocks.load(std::memory_order_relaxed);
+	numBlocks.store(blocks + 1, std::memory_order_relaxed);
+	
+	if (numSamples <= 0 || sampleRate <= 0.0)
+		return;
+	
+	const auto deadlineUsed = seconds * sampleRate / numSamples;
+	
+	// A running mean over roughly the last second's worth of blocks, so one
+	// slow block stands out in the peak without swamping the average.
+	const auto blocksPerSecond = juce::jmax(1.0, sampleRate / numSamples);
+	const auto average = averageDeadlineUsed.load(std::memory_order_relaxed);
+	const auto weight = 1.0 / juce::jmin(blocksPerSecond, (double) blocks + 1.0);
+	
+	averageDeadlineUsed.store(average + weight * (deadlineUsed - average), std::memory_order_relaxed);
+	lastDeadlineUsed.store(deadlineUsed, std::memory_order_relaxed);
+	
+	if (deadlineUsed > peakDeadlineUsed.load(std::memory_order_relaxed))
+		peakDeadlineUsed.store(deadlineUsed, std::memory_order_relaxed);
+	
+	if (deadlineUsed >= 0.5)
+		increment(numBlocksOverHalfDeadline);
+	
+	if (deadlineUsed >= 1.0)
+		increment(numOverruns);
+}
+
+void ProcessorMetrics::setActiveSections (int numSections, int chains) noexcept
+{
+	numActiveSections.store(numSections, std::memory_order_relaxed);
+	numChains.store(chains, std::memory_order_relaxed);
+}
+
+ProcessorMetrics::Snapshot ProcessorMetrics::getSnapshot() const noexcept
+{
+	Snapshot snapshot;
+	
+	for (size_t i = 0; i < durationHistogram.size(); ++i)
+		snapshot.durationHistogram[i] = durationHistogram[i].load(std::memory_order_relaxed);
+	
+	snapshot.numBlocks = numBlocks.load(std::memory_order_relaxed);
+	snapshot.numBlocksOverHalfDeadline = numBlocksOverHalfDeadline.load(std::memory_order_relaxed);
+	snapshot.numOverruns = numOverruns.load(std::memory_order_relaxed);
+	snapshot.numDenormalBlocks = numDenormalBlocks.load(std::memory_order_relaxed);
+	snapshot.numDesigns = numDesigns.load(std::memory_order_relaxed);
+	snapshot.numKernelDesigns = numKernelDesigns.load(std::memory_order_relaxed);
+	snapshot.lastDeadlineUsed = lastDeadlineUsed.load(std::memory_order_relaxed);
+	snapshot.averageDeadlineUsed = averageDeadlineUsed.load(std::memory_order_relaxed);
+	snapshot.peakDeadlineUsed = peakDeadlineUsed.load(std::memory_order_relaxed);
+	snapshot.numActiveSections = numActiveSections.load(std::memory_order_relaxed);
+	snapshot.numChains = numChains.load(std::memory_order_relaxed);
+	
+	return snapshot;
+}
+
+juce::var ProcessorMetrics::Snapshot::toVar() const
+{
+	juce::Array<juce::var> histogram;
+	
+	for (int bucket = 0; bucket < numDurationBuckets; ++bucket)
+	{
+		auto* entry = new juce::DynamicObject();
+		entry->setProperty("upToMicroseconds", bucket < numDurationBuckets - 1 ? juce::var(getBucketLimitMicroseconds(bucket)) : juce::var());
+		entry->setProperty("blocks", durationHistogram[(size_t) bucket]);
+		histogram.add(entry);
+	}
+	
+	auto* result = new juce::DynamicObject();
+	result->setProperty("blocks", numBlocks);
+	result->setProperty("durationHistogram", histogram);
+	result->setProperty("lastDeadlineUsed", lastDeadlineUsed);
+	result->setProperty("averageDeadlineUsed", averageDeadlineUsed);
+	result->setProperty("peakDeadlineUsed", peakDeadlineUsed);
+	result->setProperty("blocksOverHalfDeadline", numBlocksOverHalfDeadline);
+	result->setProperty("overruns", numOverruns);
+	result->setProperty("denormalBlocks", numDenormalBlocks);
+	result->setProperty("designs", numDesigns);
+	result->setProperty("kernelDesigns", numKernelDesigns);
+	result->setProperty("activeSections", numActiveSections);
+	result->setProperty("chains", numChains);
+	
+	return result;
+}
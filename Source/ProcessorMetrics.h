@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+    ProcessorMetrics.h
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    What one processor instance has been doing since it was last prepared:
+    how long its blocks took against their deadline, how often it redesigned,
+    whether denormals turned up in the filter state and how many sections run.
+
+    Each counter has a single writer, either the audio thread or the design
+    thread, and is a relaxed atomic, so recording never blocks or allocates.
+    getSnapshot() can be called from any thread; the fields it returns are each
+    consistent, though one may be a block ahead of another.
+*/
+class ProcessorMetrics
+{
+public:
+	// Block durations in log2-spaced buckets: bucket 0 counts blocks under 1 us,
+	// bucket n those from 2^(n-1) up to 2^n us, and the last one everything longer.
+	static constexpr int numDurationBuckets = 18;
+	
+	struct Snapshot
+	{
+		std::array<juce::int64, numDurationBuckets> durationHistogram {};
+		juce::int64 numBlocks { 0 }, numBlocksOverHalfDeadline { 0 }, numOverruns { 0 }, numDenormalBlocks { 0 };
+		juce::int64 numDesigns { 0 }, numKernelDesigns { 0 };
+		double lastDeadlineUsed { 0 }, averageDeadlineUsed { 0 }, peakDeadlineUsed { 0 };
+		int numActiveSections { 0 }, numChains { 0 };
+		
+		/** The upper edge of a histogram bucket in microseconds. */
+		static double getBucketLimitMicroseconds (int bucket) noexcept	{ return std::ldexp(1.0, bucket); }
+		
+		juce::var toVar() const;
+	};
+	
+	/** Starts counting again. Not to be called while the audio thread is recording. */
+	void reset() noexcept;
+	
+	/** Audio thread: one processBlock() call and the deadline it had to meet. */
+	void recordBlock (juce::int64 elapsedTicks, int numSamples, double sampleRate) noexcept;
+	
+	/** Audio thread: a block that left denormal values in the filter state. */
+	void recordDenormals() noexcept									{ increment(numDenormalBlocks); }
+	
+	/** Audio thread: the sections each chain ran in the last block, and how
+		many chains (one per channel) there are. Zero sections means the IIR
+		chain was skipped, because it's asleep, bypassed or in linear-phase mode.
+	*/
+	void setActiveSections (int numSections, int chains) noexcept;
+	
+	/** Design thread: a chain design or a linear-phase kernel was published. */
+	void recordDesign() noexcept									{ increment(numDesigns); }
+	void recordKernelDesign() noexcept								{ increment(numKernelDesigns); }
+	
+	Snapshot getSnapshot() const noexcept;
+
+private:
+	// Single writer, so a load and a store are enough; no read-modify-write.
+	static void increment (std::atomic<juce::int64>& counter) noexcept
+	{
+		counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+	
+	std::array<std::atomic<juce::int64>, numDurationBuckets> durationHistogram {};
+	std::atomic<juce::int64> numBlocks { 0 }, numBlocksOverHalfDeadline { 0 }, numOverruns { 0 }, numDenormalBlocks { 0 };
+	std::atomic<juce::int64> numDesigns { 0 }, numKernelDesigns { 0 };
+	std::atomic<double> lastDeadlineUsed { 0 }, averageDeadlineUsed { 0 }, peakDeadlineUsed { 0 };
+	std::atomic<int> numActiveSections { 0 }, numChains { 0 };
+};
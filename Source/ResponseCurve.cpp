@@ -0,0 +1,174 @@
+/*
+  ==============================================================================
+
+    ResponseCurve.cpp
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#include "ResponseCurve.h"
+#include "PluginProcessor.h"
+
+//==============================================================================
+ResponseCurveComponent::ResponseCurveComponent (AwesomeEQAudioProcessor& processor)
+	: audioProcessor(processor),
+	  channelParameters(processor.parameters),
+	  oversamplingValue(processor.parameters.getRawParameterValue("Oversampling"))
+{
+	setInterceptsMouseClicks(false, false);
+	
+	for (auto& needsUpdate : stageNeedsUpdate)
+		needsUpdate = true;
+	
+	for (auto* parameter : audioProcessor.getParameters())
+		if (auto* withID = dynamic_cast<juce::AudioProcessorParameterWithID*>(parameter))
+			audioProcessor.parameters.addParameterListener(withID->paramID, this);
+	
+	startTimerHz(30);
+}
+
+ResponseCurveComponent::~ResponseCurveComponent()
+{
+	for (auto* parameter : audioProcessor.getParameters())
+		if (auto* withID = dynamic_cast<juce::AudioProcessorParameterWithID*>(parameter))
+			audioProcessor.parameters.removeParameterListener(withID->paramID, this);
+}
+
+void ResponseCurveComponent::paint (juce::Graphics& g)
+{
+	g.setColour(juce::Colours::white.withAlpha(0.2f));
+	g.drawHorizontalLine(getHeight() / 2, 0.f, (float) getWidth());
+	
+	g.setColour(juce::Colours::white);
+	g.strokePath(responseCurve, juce::PathStrokeType(2.f));
+}
+
+void ResponseCurveComponent::resized()
+{
+	const auto width = (size_t) juce::jmax(0, getWidth());
+	
+	frequencies.resize(width);
+	
+	for (size_t x = 0; x < width; ++x)
+		frequencies[x] = 20.0 * std::pow(1000.0, (double) x / (double) width);
+	
+	for (auto& magnitudes : stageMagnitudes)
+		magnitudes.resize(width);
+	
+	// A new axis invalidates every stage.
+	for (auto& needsUpdate : stageNeedsUpdate)
+		needsUpdate = true;
+	
+	timerCallback();
+}
+
+void ResponseCurveComponent::parameterChanged (const juce::String& parameterID, float newValue)
+{
+	juce::ignoreUnused(newValue);
+	
+	// Band IDs are "Band1 ..." up to "Band8 ...", as in the processor.
+	if (parameterID.startsWith("Band"))
+		stageNeedsUpdate[(size_t) (Stage_FirstBand + (parameterID[4] - '1'))] = true;
+	else if (parameterID.startsWith("Lowcut"))
+		stageNeedsUpdate[Stage_LowCut] = true;
+	else if (parameterID.startsWith("Highcut"))
+		stageNeedsUpdate[Stage_HighCut] = true;
+}
+
+void ResponseCurveComponent::timerCallback()
+{
+	if (frequencies.empty())
+		return;
+	
+	// Before the host prepares us, draw the curve as it would look at 44.1 kHz.
+	// The chain runs at the oversampled rate, so that's the rate it's drawn at.
+	const auto hostSampleRate = audioProcessor.getSampleRate() > 0.0 ? audioProcessor.getSampleRate() : 44100.0;
+	const auto oversampling = static_cast<OversamplingMode>(oversamplingValue->load());
+	const auto sampleRate = hostSampleRate * getOversamplingFactor(oversampling);
+	
+	if (sampleRate != displayedSampleRate)
+	{
+		displayedSampleRate = sampleRate;
+		
+		for (auto& needsUpdate : stageNeedsUpdate)
+			needsUpdate = true;
+	}
+	
+	bool anyStageChanged = false;
+	const auto channelSettings = channelParameters.load();
+	
+	for (int stage = 0; stage < numStages; ++stage)
+	{
+		if (stageNeedsUpdate[(size_t) stage].exchange(false))
+		{
+			updateStage(static_cast<Stage>(stage), channelSettings);
+			anyStageChanged = true;
+		}
+	}
+	
+	if (anyStageChanged)
+	{
+		updatePath();
+		repaint();
+	}
+}
+
+void ResponseCurveComponent::updateStage (Stage stage, const ChannelSettings& channelSettings)
+{
+	auto& magnitudes = stageMagnitudes[(size_t) stage];
+	std::fill(magnitudes.begin(), magnitudes.end(), 1.0);
+	
+	auto applySections = [&] (const CutCoefficients& cutCoefficients, Slope slope)
+	{
+		for (size_t section = 0; section < (size_t) getNumCutSections(slope); ++section)
+			applyMagnitudeResponse(cutCoefficients[section], frequencies.data(), magnitudes.data(), magnitudes.size(), displayedSampleRate);
+	};
+	
+	switch (stage)
+	{
+		case Stage_LowCut:
+			applySections(coefficientCache->getLowCutFilter(channelSettings, displayedSampleRate), channelSettings.lowCutSlope);
+			break;
+			
+		case Stage_HighCut:
+			applySections(coefficientCache->getHighCutFilter(channelSettings, displayedSampleRate), channelSettings.highCutSlope);
+			break;
+			
+		default:
+		{
+			jassert(stage >= Stage_FirstBand && stage < numStages);
+			
+			const auto& band = channelSettings.bands[(size_t) (stage - Stage_FirstBand)];
+			
+			if (band.enabled)
+				applyMagnitudeResponse(coefficientCache->getBandFilter(band, displayedSampleRate), frequencies.data(), magnitudes.data(), magnitudes.size(), displayedSampleRate);
+			
+			break;
+		}
+	}
+}
+
+void ResponseCurveComponent::updatePath()
+{
+	responseCurve.clear();
+	
+	const auto height = (float) getHeight();
+	
+	for (size_t x = 0; x < frequencies.size(); ++x)
+	{
+		auto magnitude = 1.0;
+		
+		for (const auto& magnitudes : stageMagnitudes)
+			magnitude *= magnitudes[x];
+		
+		const auto decibels = (float) juce::Decibels::gainToDecibels(magnitude, -100.0);
+		const auto y = juce::jmap(juce::jlimit(-maxDecibels, maxDecibels, decibels), -maxDecibels, maxDecibels, height, 0.f);
+		
+		if (x == 0)
+			responseCurve.startNewSubPath(0.f, y);
+		else
+			responseCurve.lineTo((float) x, y);
+	}
+}
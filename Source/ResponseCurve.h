@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    ResponseCurve.h
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "CoefficientCache.h"
+
+class AwesomeEQAudioProcessor;
+
+//==============================================================================
+/**
+    Draws the magnitude response of the whole chain over a 20 Hz - 20 kHz
+    log axis.
+
+    Each stage keeps its own magnitudes, one per pixel column. A parameter
+    change only marks its stage dirty; the 30 Hz timer re-evaluates just that
+    stage, multiplies them all together and rebuilds the cached path. Each band
+    is a stage of its own, so dragging one doesn't re-evaluate the others. When
+    nothing moves the timer does nothing and paint() only strokes the path.
+*/
+class ResponseCurveComponent  : public juce::Component,
+                                private juce::AudioProcessorValueTreeState::Listener,
+                                private juce::Timer
+{
+public:
+	explicit ResponseCurveComponent (AwesomeEQAudioProcessor& processor);
+	~ResponseCurveComponent() override;
+	
+	void paint (juce::Graphics& g) override;
+	void resized() override;
+	
+	static constexpr float maxDecibels = 24.f;
+	
+private:
+	enum Stage
+	{
+		Stage_LowCut,
+		Stage_HighCut,
+		Stage_FirstBand,
+		numStages = Stage_FirstBand + maxNumBands
+	};
+	
+	void parameterChanged (const juce::String& parameterID, float newValue) override;
+	void timerCallback() override;
+	
+	void updateStage (Stage stage, const ChannelSettings& channelSettings);
+	void updatePath();
+	
+	AwesomeEQAudioProcessor& audioProcessor;
+	const ChannelParameters channelParameters;
+	std::atomic<float>* const oversamplingValue;
+	juce::SharedResourcePointer<CoefficientCache> coefficientCache;
+	
+	// Parameter callbacks can arrive on any thread, so they only set these.
+	std::array<std::atomic<bool>, numStages> stageNeedsUpdate;
+	double displayedSampleRate { 0.0 };
+	
+	std::vector<double> frequencies;
+	std::array<std::vector<double>, numStages> stageMagnitudes;
+	
+	juce::Path responseCurve;
+	
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ResponseCurveComponent)
+};
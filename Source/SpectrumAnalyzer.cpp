@@ -0,0 +1,184 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.cpp
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyzer.h"
+#include "PluginProcessor.h"
+
+//==============================================================================
+SpectrumAnalysis::SpectrumAnalysis (AnalyzerFifo& source)
+	: fifo(source), history((size_t) fftSize), fftData((size_t) fftSize * 2)
+{
+	smoothedSpectrum.fill(minDecibels);
+	thread->addTimeSliceClient(this);
+}
+
+SpectrumAnalysis::~SpectrumAnalysis()
+{
+	thread->removeTimeSliceClient(this);
+}
+
+int SpectrumAnalysis::useTimeSlice()
+{
+	constexpr int hopSize = fftSize / 4;
+	constexpr float decayPerFrame = 1.5f;
+	
+	// Drain the fifo into a circular window of the most recent fftSize samples.
+	for (;;)
+	{
+		const auto maxToRead = fftSize - historyPosition;
+		const auto numRead = fifo.pull(history.data() + historyPosition, maxToRead);
+		
+		historyPosition = (historyPosition + numRead) % fftSize;
+		numNewSamples += numRead;
+		
+		if (numRead < maxToRead)
+			break;
+	}
+	
+	if (numNewSamples < hopSize)
+		return 15;
+	
+	numNewSamples = 0;
+	
+	std::copy(history.begin() + historyPosition, history.end(), fftData.begin());
+	std::copy(history.begin(), history.begin() + historyPosition, fftData.begin() + (fftSize - historyPosition));
+	
+	window.multiplyWithWindowingTable(fftData.data(), (size_t) fftSize);
+	fft.performFrequencyOnlyForwardTransform(fftData.data());
+	
+	// A full-scale sine reads 0 dB: the Hann window halves the amplitude and
+	// each side of the spectrum carries half of it.
+	const auto scale = 4.f / (float) fftSize;
+	
+	for (size_t bin = 0; bin < (size_t) numBins; ++bin)
+	{
+		const auto decibels = juce::Decibels::gainToDecibels(fftData[bin] * scale, minDecibels);
+		smoothedSpectrum[bin] = juce::jmax(decibels, smoothedSpectrum[bin] - decayPerFrame);
+	}
+	
+	spectra.write(smoothedSpectrum);
+	return 0;
+}
+
+//==============================================================================
+SpectrumAnalyzerComponent::SpectrumAnalyzerComponent (AwesomeEQAudioProcessor& processor)
+	: audioProcessor(processor)
+{
+	setOpaque(true);
+	
+	if (audioProcessor.attachAnalyzer())
+	{
+		preAnalysis = std::make_unique<SpectrumAnalysis>(audioProcessor.getPreAnalyzerFifo());
+		postAnalysis = std::make_unique<SpectrumAnalysis>(audioProcessor.getPostAnalyzerFifo());
+		startTimerHz(30);
+	}
+}
+
+SpectrumAnalyzerComponent::~SpectrumAnalyzerComponent()
+{
+	if (preAnalysis != nullptr)
+	{
+		preAnalysis.reset();
+		postAnalysis.reset();
+		audioProcessor.detachAnalyzer();
+	}
+}
+
+void SpectrumAnalyzerComponent::paint (juce::Graphics& g)
+{
+	g.fillAll(juce::Colours::black);
+	
+	// Decade grid lines at 100 Hz, 1 kHz and 10 kHz.
+	g.setColour(juce::Colours::white.withAlpha(0.1f));
+	
+	for (auto frequency : { 100.0, 1000.0, 10000.0 })
+		g.drawVerticalLine(juce::roundToInt(frequencyToProportion(frequency) * getWidth()), 0.f, (float) getHeight());
+	
+	g.setColour(juce::Colours::skyblue.withAlpha(0.6f));
+	g.strokePath(prePath, juce::PathStrokeType(1.f));
+	
+	g.setColour(juce::Colours::orange);
+	g.strokePath(postPath, juce::PathStrokeType(1.5f));
+}
+
+void SpectrumAnalyzerComponent::resized()
+{
+	prePath.clear();
+	postPath.clear();
+}
+
+void SpectrumAnalyzerComponent::timerCallback()
+{
+	bool needsRepaint = false;
+	
+	if (preAnalysis->pullSpectrum())
+	{
+		updatePath(prePath, preAnalysis->getSpectrum());
+		needsRepaint = true;
+	}
+	
+	if (postAnalysis->pullSpectrum())
+	{
+		updatePath(postPath, postAnalysis->getSpectrum());
+		needsRepaint = true;
+	}
+	
+	if (needsRepaint)
+		repaint();
+}
+
+void SpectrumAnalyzerComponent::updatePath (juce::Path& path, const SpectrumAnalysis::Spectrum& spectrum) const
+{
+	path.clear();
+	
+	const auto sampleRate = audioProcessor.getSampleRate();
+	const auto width = getWidth();
+	const auto height = (float) getHeight();
+	
+	if (sampleRate <= 0.0 || width <= 0)
+		return;
+	
+	// One point per pixel column on a 20 Hz - 20 kHz log axis, taking the
+	// loudest bin that falls in the column.
+	const auto binsPerHertz = (double) SpectrumAnalysis::fftSize / sampleRate;
+	auto getBin = [&] (int x)
+	{
+		const auto frequency = proportionToFrequency((double) x / (double) width);
+		return juce::jlimit(1, SpectrumAnalysis::numBins - 1, (int) (frequency * binsPerHertz));
+	};
+	
+	for (int x = 0; x < width; ++x)
+	{
+		const auto firstBin = getBin(x);
+		const auto lastBin = juce::jmax(firstBin, getBin(x + 1) - 1);
+		
+		auto decibels = SpectrumAnalysis::minDecibels;
+		
+		for (auto bin = firstBin; bin <= lastBin; ++bin)
+			decibels = juce::jmax(decibels, spectrum[(size_t) bin]);
+		
+		const auto y = juce::jmap(decibels, SpectrumAnalysis::minDecibels, 6.f, height, 0.f);
+		
+		if (x == 0)
+			path.startNewSubPath(0.f, y);
+		else
+			path.lineTo((float) x, y);
+	}
+}
+
+double SpectrumAnalyzerComponent::proportionToFrequency (double proportion) noexcept
+{
+	return 20.0 * std::pow(1000.0, proportion);
+}
+
+double SpectrumAnalyzerComponent::frequencyToProportion (double frequency) noexcept
+{
+	return std::log(frequency / 20.0) / std::log(1000.0);
+}
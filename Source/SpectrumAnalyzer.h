@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.h
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "AnalyzerFifo.h"
+#include "TripleBuffer.h"
+
+class AwesomeEQAudioProcessor;
+
+//==============================================================================
+/**
+    Turns the samples arriving through an AnalyzerFifo into a smoothed
+    magnitude spectrum in decibels.
+
+    The FFTs run on a TimeSliceThread shared by every analyzer in the process,
+    never on the audio or message thread. Finished spectra are handed to the
+    GUI through a TripleBuffer, so the editor only ever copies the latest one.
+*/
+class SpectrumAnalysis  : private juce::TimeSliceClient
+{
+public:
+	static constexpr int fftOrder = 11;
+	static constexpr int fftSize = 1 << fftOrder;
+	static constexpr int numBins = fftSize / 2;
+	
+	using Spectrum = std::array<float, numBins>;
+	
+	static constexpr float minDecibels = -90.f;
+	
+	explicit SpectrumAnalysis (AnalyzerFifo& source);
+	~SpectrumAnalysis() override;
+	
+	/** GUI side: returns true if a new spectrum is available through getSpectrum(). */
+	bool pullSpectrum()							{ return spectra.pull(); }
+	const Spectrum& getSpectrum() const			{ return spectra.read(); }
+	
+private:
+	struct AnalysisThread  : public juce::TimeSliceThread
+	{
+		AnalysisThread()	: juce::TimeSliceThread("AwesomeEQ Analyzer")	{ startThread(); }
+		~AnalysisThread() override										{ stopThread(1000); }
+	};
+	
+	int useTimeSlice() override;
+	
+	AnalyzerFifo& fifo;
+	
+	juce::dsp::FFT fft { fftOrder };
+	juce::dsp::WindowingFunction<float> window { (size_t) fftSize, juce::dsp::WindowingFunction<float>::hann, false };
+	
+	std::vector<float> history, fftData;
+	int historyPosition { 0 }, numNewSamples { 0 };
+	
+	Spectrum smoothedSpectrum;
+	TripleBuffer<Spectrum> spectra;
+	
+	juce::SharedResourcePointer<AnalysisThread> thread;
+	
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumAnalysis)
+};
+
+//==============================================================================
+/**
+    Draws the pre- and post-filter spectra of an AwesomeEQAudioProcessor.
+
+    A 30 Hz timer picks up new spectra and rebuilds two cached paths; paint()
+    only strokes them, so frame time stays bounded however busy the audio is.
+*/
+class SpectrumAnalyzerComponent  : public juce::Component,
+                                   private juce::Timer
+{
+public:
+	explicit SpectrumAnalyzerComponent (AwesomeEQAudioProcessor& processor);
+	~SpectrumAnalyzerComponent() override;
+	
+	void paint (juce::Graphics& g) override;
+	void resized() override;
+	
+private:
+	void timerCallback() override;
+	void updatePath (juce::Path& path, const SpectrumAnalysis::Spectrum& spectrum) const;
+	
+	// The x axis runs from 20 Hz to 20 kHz on a log scale; a proportion of 0 is
+	// the left edge and 1 the right.
+	static double proportionToFrequency (double proportion) noexcept;
+	static double frequencyToProportion (double frequency) noexcept;
+	
+	AwesomeEQAudioProcessor& audioProcessor;
+	
+	// Null if another analyzer is already attached to this processor.
+	std::unique_ptr<SpectrumAnalysis> preAnalysis, postAnalysis;
+	
+	juce::Path prePath, postPath;
+	
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumAnalyzerComponent)
+};
@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+    TripleBuffer.h
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Lock-free single-producer/single-consumer handoff of a value.
+
+    The producer always has a private slot to write into and the consumer
+    always has a private slot to read from; a third slot is swapped between
+    them atomically. Neither side ever blocks or allocates, and the consumer
+    only ever sees the most recently published value.
+*/
+template <typename Type>
+class TripleBuffer
+{
+public:
+	/** Producer side: copies the value into the back slot and publishes it. */
+	void write (const Type& value)
+	{
+		getBackBuffer() = value;
+		publish();
+	}
+	
+	/** Producer side: the back slot, for building a large value in place instead
+		of copying it in. It holds whatever was last there, so fill it completely,
+		then publish().
+	*/
+	Type& getBackBuffer()		{ return buffers[(size_t) backIndex]; }
+	
+	void publish()
+	{
+		backIndex = state.exchange(backIndex | freshBit, std::memory_order_acq_rel) & indexMask;
+	}
+	
+	/** Consumer side: returns true if a value has been published since the last call,
+		in which case read() now refers to it.
+	*/
+	bool pull()
+	{
+		if ((state.load(std::memory_order_relaxed) & freshBit) == 0)
+			return false;
+		
+		frontIndex = state.exchange(frontIndex, std::memory_order_acq_rel) & indexMask;
+		return true;
+	}
+	
+	/** Consumer side: the value fetched by the last successful pull(). */
+	const Type& read() const	{ return buffers[(size_t) frontIndex]; }
+	
+private:
+	static constexpr int indexMask = 3, freshBit = 4;
+	
+	std::array<Type, 3> buffers {};
+	std::atomic<int> state { 1 };
+	int backIndex { 0 }, frontIndex { 2 };
+	
+	JUCE_DECLARE_NON_COPYABLE (TripleBuffer)
+};
@@ -0,0 +1,1408 @@
+/*
+  ==============================================================================
+
+    Benchmark.cpp
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+#include "RealtimeChecks.h"
+#include "../../../Source/BlockParallelCascade.h"
+#include "../../../Source/MultiStreamEQ.h"
+#include "../../../Source/PluginProcessor.h"
+
+namespace
+{
+	constexpr double sampleRates[] { 44100.0, 48000.0, 96000.0, 192000.0 };
+	constexpr int blockSizes[] { 32, 64, 256, 1024, 4096 };
+	constexpr int numChannels = 2;
+	
+	void setParameter (AwesomeEQAudioProcessor& processor, const juce::String& parameterID, float value)
+	{
+		auto* parameter = processor.parameters.getParameter(parameterID);
+		jassert(parameter != nullptr);
+		parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+	}
+	
+	void setChannelSettings (AwesomeEQAudioProcessor& processor, const ChannelSettings& channelSettings)
+	{
+		setParameter(processor, "Lowcut Freq", channelSettings.lowCutFreq);
+		setParameter(processor, "Highcut Freq", channelSettings.highCutFreq);
+		setParameter(processor, "Lowcut Slope", (float) channelSettings.lowCutSlope);
+		setParameter(processor, "Highcut Slope", (float) channelSettings.highCutSlope);
+		
+		for (int i = 0; i < maxNumBands; ++i)
+		{
+			const auto& ids = getBandParameterIDs(i);
+			const auto& band = channelSettings.bands[(size_t) i];
+			
+			setParameter(processor, ids.enabled, band.enabled ? 1.f : 0.f);
+			setParameter(processor, ids.type, (float) band.type);
+			setParameter(processor, ids.freq, band.freq);
+			setParameter(processor, ids.gain, band.gainInDecibels);
+			setParameter(processor, ids.quality, band.quality);
+		}
+	}
+	
+	// Settings a stream on a server might have: both cuts and four bands of any
+	// type, on the parameter steps so the processor sees exactly the same curve.
+	ChannelSettings makeRandomSettings (juce::Random& random)
+	{
+		ChannelSettings channelSettings;
+		channelSettings.lowCutFreq = (float) juce::roundToInt(20.f + 180.f * random.nextFloat());
+		channelSettings.highCutFreq = (float) juce::roundToInt(5000.f + 15000.f * random.nextFloat());
+		channelSettings.lowCutSlope = static_cast<Slope>(random.nextInt(4));
+		channelSettings.highCutSlope = static_cast<Slope>(random.nextInt(4));
+		
+		for (size_t i = 0; i < 4; ++i)
+		{
+			auto& band = channelSettings.bands[i];
+			band.enabled = true;
+			band.type = static_cast<BandType>(random.nextInt(4));
+			band.freq = (float) juce::roundToInt(100.f * std::pow(100.f, random.nextFloat()));
+			band.gainInDecibels = (float) random.nextInt({ -24, 25 }) * 0.5f;
+			band.quality = (float) random.nextInt({ 10, 60 }) * 0.05f;
+		}
+		
+		return channelSettings;
+	}
+	
+	juce::String getSlopeName (Slope slope)
+	{
+		return juce::String(12 + (int) slope * 12) + " dB/Oct";
+	}
+	
+	// What the parameter changes of an automated case did on the thread that sent them.
+	void addAutomationCounts (juce::DynamicObject& result, const RealtimeChecks::Counts& automationCounts)
+	{
+		result.setProperty("automationAllocations", automationCounts.allocations);
+		result.setProperty("automationDeallocations", automationCounts.deallocations);
+		result.setProperty("automationLocks", automationCounts.locks);
+	}
+	
+	struct IgnoreBlock
+	{
+		template <typename SampleType>
+		void operator() (const juce::AudioBuffer<SampleType>&, int) const noexcept {}
+	};
+	
+	// The fixture every processBlock() case shares, for a processor that's already
+	// prepared. Before each block, fillBlock (buffer, block) fills the buffer and
+	// does whatever else a host would between blocks; after it, checkBlock (buffer,
+	// block) can look at the output. Blocks numbered below zero are warm-up: they
+	// are watched by the realtime checks like the rest, but not timed.
+	template <typename SampleType = float, typename FillFunction, typename CheckFunction = IgnoreBlock>
+	juce::DynamicObject* timeProcessBlock (AwesomeEQAudioProcessor& processor, double sampleRate, int blockSize, int numBufferChannels,
+										   double seconds, int numWarmUpBlocks, FillFunction&& fillBlock, CheckFunction&& checkBlock = {})
+	{
+		juce::AudioBuffer<SampleType> buffer (numBufferChannels, blockSize);
+		juce::MidiBuffer midiMessages;
+		
+		const auto numBlocks = juce::jmax(1, (int) (seconds * sampleRate) / blockSize);
+		juce::int64 totalTicks = 0, worstTicks = 0;
+		RealtimeChecks::Counts counts;
+		
+		for (int block = -numWarmUpBlocks; block < numBlocks; ++block)
+		{
+			fillBlock(buffer, block);
+			
+			const auto start = juce::Time::getHighResolutionTicks();
+			
+			{
+				const RealtimeChecks::Scope scope (counts);
+				processor.processBlock(buffer, midiMessages);
+			}
+			
+			const auto elapsed = juce::Time::getHighResolutionTicks() - start;
+			
+			if (block >= 0)
+			{
+				totalTicks += elapsed;
+				worstTicks = juce::jmax(worstTicks, elapsed);
+			}
+			
+			checkBlock(buffer, block);
+		}
+		
+		auto* result = new juce::DynamicObject();
+		result->setProperty("sampleRate", sampleRate);
+		result->setProperty("blockSize", blockSize);
+		result->setProperty("nsPerSample", juce::Time::highResolutionTicksToSeconds(totalTicks) * 1.0e9 / ((double) numBlocks * blockSize));
+		result->setProperty("worstBlockDeadlineUsed", juce::Time::highResolutionTicksToSeconds(worstTicks) * sampleRate / blockSize);
+		result->setProperty("allocations", counts.allocations);
+		result->setProperty("deallocations", counts.deallocations);
+		result->setProperty("locks", counts.locks);
+		
+		return result;
+	}
+	
+	// Fills every channel with white noise, the same sequence on every run.
+	struct Noise
+	{
+		juce::Random random { 1 };
+		
+		template <typename SampleType>
+		void operator() (juce::AudioBuffer<SampleType>& buffer, int)
+		{
+			for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+				for (int i = 0; i < buffer.getNumSamples(); ++i)
+					buffer.setSample(channel, i, (SampleType) (random.nextFloat() * 2.f - 1.f));
+		}
+	};
+	
+	// Some state only reaches the audio thread after prepareToPlay(), once the
+	// design thread has published it. This runs untimed blocks of noise until
+	// isReady() says it has arrived, or gives up after two seconds.
+	template <typename ReadyFunction>
+	bool processUntilReady (AwesomeEQAudioProcessor& processor, int blockSize, int numBufferChannels, ReadyFunction&& isReady)
+	{
+		juce::AudioBuffer<float> buffer (numBufferChannels, blockSize);
+		juce::MidiBuffer midiMessages;
+		Noise noise;
+		const auto timeout = juce::Time::getMillisecondCounter() + 2000;
+		
+		while (! isReady())
+		{
+			if (juce::Time::getMillisecondCounter() > timeout)
+			{
+				jassertfalse;
+				return false;
+			}
+			
+			noise(buffer, 0);
+			processor.processBlock(buffer, midiMessages);
+			juce::Thread::sleep(1);
+		}
+		
+		return true;
+	}
+	
+	juce::var runCase (AwesomeEQAudioProcessor& processor, double sampleRate, int blockSize, Slope slope, bool automated,
+					   OversamplingMode oversampling, double seconds)
+	{
+		// Every stage active: both cuts at the slope under test and a boosted first band.
+		setParameter(processor, "Lowcut Freq", 80.f);
+		setParameter(processor, "Highcut Freq", 12000.f);
+		setParameter(processor, getBandParameterIDs(0).freq, 1000.f);
+		setParameter(processor, getBandParameterIDs(0).gain, 6.f);
+		setParameter(processor, "Lowcut Slope", (float) slope);
+		setParameter(processor, "Highcut Slope", (float) slope);
+		setParameter(processor, "Oversampling", (float) oversampling);
+		
+		processor.releaseResources();
+		processor.setPlayConfigDetails(numChannels, numChannels, sampleRate, blockSize);
+		processor.prepareToPlay(sampleRate, blockSize);
+		
+		const auto numBlocks = juce::jmax(1, (int) (seconds * sampleRate) / blockSize);
+		RealtimeChecks::Counts automationCounts;
+		Noise noise;
+		
+		auto* result = timeProcessBlock(processor, sampleRate, blockSize, numChannels, seconds, juce::jmax(8, numBlocks / 20), [&] (auto& buffer, int block)
+		{
+			noise(buffer, block);
+			
+			if (automated)
+			{
+				// A slow sweep of both the low cut and the first band, as a host would
+				// send it between blocks. Hosts do that on the audio thread, so the
+				// listener path it runs through is watched too, though not timed.
+				const RealtimeChecks::Scope scope (automationCounts);
+				const auto phase = std::sin(juce::MathConstants<double>::twoPi * block * blockSize / sampleRate);
+				setParameter(processor, "Lowcut Freq", (float) (200.0 + 150.0 * phase));
+				setParameter(processor, getBandParameterIDs(0).freq, (float) (1000.0 + 800.0 * phase));
+			}
+		});
+		
+		result->setProperty("slope", getSlopeName(slope));
+		result->setProperty("automated", automated);
+		result->setProperty("oversampling", getOversamplingFactor(oversampling));
+		result->setProperty("latencySamples", processor.getLatencySamples());
+		
+		if (automated)
+			addAutomationCounts(*result, automationCounts);
+		
+		return result;
+	}
+	
+	// The path the processor started from: per channel, a ProcessorChain of
+	// scalar IIR::Filter<float>, four for each cut and one for the band.
+	using ScalarFilter = juce::dsp::IIR::Filter<float>;
+	using ScalarCutFilter = juce::dsp::ProcessorChain<ScalarFilter, ScalarFilter, ScalarFilter, ScalarFilter>;
+	using ScalarChain = juce::dsp::ProcessorChain<ScalarCutFilter, ScalarFilter, ScalarCutFilter>;
+	
+	void setScalarFilter (ScalarFilter& filter, const Coefficients& coefficients)
+	{
+		filter.coefficients = new juce::dsp::IIR::Coefficients<float> ((float) coefficients[0], (float) coefficients[1], (float) coefficients[2],
+																	  (float) coefficients[3], (float) coefficients[4], (float) coefficients[5]);
+	}
+	
+	void setScalarCutFilter (ScalarCutFilter& cutFilter, const CutCoefficients& cutCoefficients)
+	{
+		setScalarFilter(cutFilter.get<0>(), cutCoefficients[0]);
+		setScalarFilter(cutFilter.get<1>(), cutCoefficients[1]);
+		setScalarFilter(cutFilter.get<2>(), cutCoefficients[2]);
+		setScalarFilter(cutFilter.get<3>(), cutCoefficients[3]);
+	}
+	
+	// The same nine sections, both cuts at 48 dB/Oct and one band, through two
+	// scalar chains and through one SIMD cascade.
+	juce::var runCascadeBaselineCase (double sampleRate, int blockSize, double seconds)
+	{
+		ChannelSettings channelSettings;
+		channelSettings.lowCutFreq = 80.f;
+		channelSettings.highCutFreq = 12000.f;
+		channelSettings.lowCutSlope = channelSettings.highCutSlope = Slope_48;
+		channelSettings.bands[0].enabled = true;
+		channelSettings.bands[0].gainInDecibels = 6.f;
+		
+		const auto design = makeChainCoefficients(channelSettings, sampleRate);
+		const auto numSections = 2 * getNumCutSections(Slope_48) + 1;
+		
+		std::array<ScalarChain, (size_t) numChannels> scalarChains;
+		
+		for (auto& chain : scalarChains)
+		{
+			setScalarCutFilter(chain.get<0>(), design.lowCut);
+			setScalarFilter(chain.get<1>(), design.bands[0]);
+			setScalarCutFilter(chain.get<2>(), design.highCut);
+			chain.prepare({ sampleRate, (juce::uint32) blockSize, 1 });
+		}
+		
+		BiquadCascade<float> cascade;
+		cascade.prepare({ sampleRate, (juce::uint32) blockSize, (juce::uint32) numChannels });
+		
+		for (int i = 0; i < getNumCutSections(Slope_48); ++i)
+		{
+			cascade.setSection(ChainPositions::Lowcut + i, design.lowCut[(size_t) i]);
+			cascade.setSection(ChainPositions::HighCut + i, design.highCut[(size_t) i]);
+			cascade.setSectionEnabled(ChainPositions::Lowcut + i, true);
+			cascade.setSectionEnabled(ChainPositions::HighCut + i, true);
+		}
+		
+		cascade.setSection(ChainPositions::Bands, design.bands[0]);
+		cascade.setSectionEnabled(ChainPositions::Bands, true);
+		
+		juce::AudioBuffer<float> scalarBuffer (numChannels, blockSize), cascadeBuffer (numChannels, blockSize);
+		Noise noise;
+		
+		const auto numBlocks = juce::jmax(1, (int) (seconds * sampleRate) / blockSize);
+		juce::int64 scalarTicks = 0, cascadeTicks = 0;
+		double maxDifference = 0.0;
+		
+		for (int block = 0; block < numBlocks; ++block)
+		{
+			noise(scalarBuffer, block);
+			cascadeBuffer.makeCopyOf(scalarBuffer, true);
+			
+			auto start = juce::Time::getHighResolutionTicks();
+			juce::dsp::AudioBlock<float> scalarBlock (scalarBuffer);
+			
+			for (size_t channel = 0; channel < scalarChains.size(); ++channel)
+			{
+				auto channelBlock = scalarBlock.getSingleChannelBlock(channel);
+				scalarChains[channel].process(juce::dsp::ProcessContextReplacing<float> (channelBlock));
+			}
+			
+			scalarTicks += juce::Time::getHighResolutionTicks() - start;
+			start = juce::Time::getHighResolutionTicks();
+			
+			juce::dsp::AudioBlock<float> cascadeBlock (cascadeBuffer);
+			cascade.process(juce::dsp::ProcessContextReplacing<float> (cascadeBlock));
+			
+			cascadeTicks += juce::Time::getHighResolutionTicks() - start;
+			
+			for (int channel = 0; channel < numChannels; ++channel)
+				for (int i = 0; i < blockSize; ++i)
+					maxDifference = juce::jmax(maxDifference, (double) std::abs(scalarBuffer.getSample(channel, i) - cascadeBuffer.getSample(channel, i)));
+		}
+		
+		const auto totalSamples = (double) numBlocks * blockSize;
+		const auto scalarNsPerSample = juce::Time::highResolutionTicksToSeconds(scalarTicks) * 1.0e9 / totalSamples;
+		const auto cascadeNsPerSample = juce::Time::highResolutionTicksToSeconds(cascadeTicks) * 1.0e9 / totalSamples;
+		
+		auto* result = new juce::DynamicObject();
+		result->setProperty("sampleRate", sampleRate);
+		result->setProperty("blockSize", blockSize);
+		result->setProperty("sections", numSections);
+		result->setProperty("scalarNsPerSample", scalarNsPerSample);
+		result->setProperty("cascadeNsPerSample", cascadeNsPerSample);
+		result->setProperty("speedUp", cascadeNsPerSample > 0.0 ? scalarNsPerSample / cascadeNsPerSample : 0.0);
+		result->setProperty("maxDifference", maxDifference);
+		
+		return result;
+	}
+	
+	juce::var runDesignCase (Slope slope, double sampleRate)
+	{
+		constexpr int numDesigns = 20000;
+		
+		ChannelSettings channelSettings;
+		channelSettings.lowCutSlope = channelSettings.highCutSlope = slope;
+		channelSettings.highCutFreq = 12000.f;
+		channelSettings.bands[0].enabled = true;
+		channelSettings.bands[0].gainInDecibels = 6.f;
+		
+		// The same sweep is designed from scratch and through a cold cache, so
+		// the second figure includes the misses that fill it.
+		auto timeDesigns = [&] (auto&& design)
+		{
+			double sink = 0.0;
+			const auto start = juce::Time::getHighResolutionTicks();
+			
+			for (int i = 0; i < numDesigns; ++i)
+			{
+				channelSettings.lowCutFreq = 20.f + (float) (i % 500);
+				channelSettings.bands[0].freq = 200.f + (float) (i % 1000);
+				sink += design().bands[0][0];
+			}
+			
+			juce::ignoreUnused(sink);
+			return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start) * 1.0e9 / numDesigns;
+		};
+		
+		CoefficientCache cache;
+		
+		auto* result = new juce::DynamicObject();
+		result->setProperty("slope", getSlopeName(slope));
+		result->setProperty("sampleRate", sampleRate);
+		result->setProperty("nsPerDesign", timeDesigns([&] { return makeChainCoefficients(channelSettings, sampleRate); }));
+		result->setProperty("nsPerCachedDesign", timeDesigns([&] { return cache.makeChainCoefficients(channelSettings, sampleRate); }));
+		result->setProperty("cacheHitRate", cache.getStatistics().getHitRate());
+		
+		return result;
+	}
+	
+	juce::var runPeakAccuracyCase (double sampleRate, float peakFreq)
+	{
+		constexpr int numDesigns = 20000;
+		constexpr int numPoints = 512;
+		
+		BandSettings band;
+		band.freq = peakFreq;
+		band.gainInDecibels = 12.f;
+		band.quality = 1.f;
+		band.enabled = true;
+		
+		// Worst deviation in dB from the analog prototype over 20 Hz up to
+		// 20 kHz, or 95% of Nyquist if that's lower.
+		std::vector<double> frequencies (numPoints), magnitudes (numPoints);
+		const auto maxFrequency = juce::jmin(20000.0, 0.95 * sampleRate / 2.0);
+		
+		for (int i = 0; i < numPoints; ++i)
+			frequencies[(size_t) i] = 20.0 * std::pow(maxFrequency / 20.0, (double) i / (numPoints - 1));
+		
+		auto getMaxError = [&] (const Coefficients& coefficients, double designSampleRate)
+		{
+			std::fill(magnitudes.begin(), magnitudes.end(), 1.0);
+			applyMagnitudeResponse(coefficients, frequencies.data(), magnitudes.data(), magnitudes.size(), designSampleRate);
+			
+			const auto A = std::sqrt(juce::Decibels::decibelsToGain((double) band.gainInDecibels));
+			const auto Q = (double) band.quality;
+			double maxError = 0.0;
+			
+			for (size_t i = 0; i < magnitudes.size(); ++i)
+			{
+				const std::complex<double> s (0.0, frequencies[i] / (double) peakFreq);
+				const auto analog = std::abs((s * s + s * (A / Q) + 1.0) / (s * s + s / (A * Q) + 1.0));
+				maxError = juce::jmax(maxError, std::abs(juce::Decibels::gainToDecibels(magnitudes[i] / analog)));
+			}
+			
+			return maxError;
+		};
+		
+		auto timeDesigns = [&] (auto&& design)
+		{
+			double sink = 0.0;
+			const auto start = juce::Time::getHighResolutionTicks();
+			
+			for (int i = 0; i < numDesigns; ++i)
+			{
+				band.freq = peakFreq + (float) (i % 100);
+				sink += design()[0];
+			}
+			
+			band.freq = peakFreq;
+			juce::ignoreUnused(sink);
+			return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start) * 1.0e9 / numDesigns;
+		};
+		
+		auto* result = new juce::DynamicObject();
+		result->setProperty("sampleRate", sampleRate);
+		result->setProperty("peakFreq", peakFreq);
+		result->setProperty("maxErrorDb1x", getMaxError(makeBandFilter(band, sampleRate), sampleRate));
+		result->setProperty("maxErrorDb2x", getMaxError(makeBandFilter(band, sampleRate * 2), sampleRate * 2));
+		result->setProperty("maxErrorDb4x", getMaxError(makeBandFilter(band, sampleRate * 4), sampleRate * 4));
+		result->setProperty("maxErrorDbMatched", getMaxError(makeMatchedPeakFilter(band, sampleRate), sampleRate));
+		result->setProperty("nsPerDesign", timeDesigns([&] { return makeBandFilter(band, sampleRate); }));
+		result->setProperty("nsPerMatchedDesign", timeDesigns([&] { return makeMatchedPeakFilter(band, sampleRate); }));
+		
+		return result;
+	}
+	
+	template <typename SampleType>
+	juce::var runPrecisionCase (AwesomeEQAudioProcessor& processor, double sampleRate, FilterPrecision filterPrecision,
+								double seconds, std::vector<double>& reference)
+	{
+		constexpr int blockSize = 256;
+		constexpr bool isDoubleBuffer = std::is_same<SampleType, double>::value;
+		
+		// A steep, very low cut is where float state starts to show its limits at high rates.
+		setParameter(processor, "Lowcut Freq", 20.f);
+		setParameter(processor, "Highcut Freq", 20000.f);
+		setParameter(processor, getBandParameterIDs(0).freq, 1000.f);
+		setParameter(processor, getBandParameterIDs(0).gain, 6.f);
+		setParameter(processor, "Lowcut Slope", (float) Slope_48);
+		setParameter(processor, "Highcut Slope", (float) Slope_12);
+		setParameter(processor, "Oversampling", (float) Oversampling_Off);
+		setParameter(processor, "Filter Precision", (float) filterPrecision);
+		
+		processor.releaseResources();
+		processor.setProcessingPrecision(isDoubleBuffer ? juce::AudioProcessor::doublePrecision : juce::AudioProcessor::singlePrecision);
+		processor.setPlayConfigDetails(numChannels, numChannels, sampleRate, blockSize);
+		processor.prepareToPlay(sampleRate, blockSize);
+		
+		double maxError = 0.0;
+		
+		// The double run goes first and leaves its output as the reference for the others.
+		const bool isReference = reference.empty();
+		
+		auto checkOutput = [&] (const juce::AudioBuffer<SampleType>& buffer, int block)
+		{
+			for (int i = 0; i < blockSize; ++i)
+			{
+				const auto output = (double) buffer.getSample(0, i);
+				
+				if (isReference)
+					reference.push_back(output);
+				else
+					maxError = juce::jmax(maxError, std::abs(output - reference[(size_t) (block * blockSize + i)]));
+			}
+		};
+		
+		auto* result = timeProcessBlock<SampleType>(processor, sampleRate, blockSize, numChannels, seconds, 0, Noise(), checkOutput);
+		
+		processor.releaseResources();
+		processor.setProcessingPrecision(juce::AudioProcessor::singlePrecision);
+		setParameter(processor, "Filter Precision", (float) Precision_Float);
+		
+		result->setProperty("io", isDoubleBuffer ? "double" : "float");
+		result->setProperty("state", filterPrecision == Precision_Double || isDoubleBuffer ? "double" : "float");
+		result->setProperty("maxErrorVsDouble", maxError);
+		
+		return result;
+	}
+	
+	juce::var runAutomationCase (AwesomeEQAudioProcessor& processor, int blockSize, AutomationResolution resolution, double seconds)
+	{
+		constexpr double sampleRate = 48000.0;
+		
+		setParameter(processor, "Lowcut Freq", 80.f);
+		setParameter(processor, "Highcut Freq", 12000.f);
+		setParameter(processor, getBandParameterIDs(0).freq, 1000.f);
+		setParameter(processor, getBandParameterIDs(0).gain, 6.f);
+		setParameter(processor, "Lowcut Slope", (float) Slope_24);
+		setParameter(processor, "Highcut Slope", (float) Slope_24);
+		setParameter(processor, "Oversampling", (float) Oversampling_Off);
+		setParameter(processor, "Automation Resolution", (float) resolution);
+		
+		processor.releaseResources();
+		processor.setPlayConfigDetails(numChannels, numChannels, sampleRate, blockSize);
+		processor.prepareToPlay(sampleRate, blockSize);
+		
+		RealtimeChecks::Counts automationCounts;
+		Noise noise;
+		
+		auto* result = timeProcessBlock(processor, sampleRate, blockSize, numChannels, seconds, 0, [&] (auto& buffer, int block)
+		{
+			noise(buffer, block);
+			
+			// A fast sweep of the first band, moved every block, watched like the
+			// block itself since hosts send it on the audio thread. The pause stands in
+			// for the rest of the callback period, in which the design thread publishes the move.
+			const auto phase = std::sin(juce::MathConstants<double>::twoPi * 4.0 * block * blockSize / sampleRate);
+			
+			{
+				const RealtimeChecks::Scope scope (automationCounts);
+				setParameter(processor, getBandParameterIDs(0).freq, (float) (1000.0 + 800.0 * phase));
+			}
+			
+			juce::Thread::sleep(1);
+		});
+		
+		const auto interval = getAutomationInterval(resolution);
+		const auto numSteps = interval > 0 ? juce::jmin(DesignTrajectory::maxNumSteps, (blockSize + interval - 1) / interval) : 1;
+		
+		setParameter(processor, "Automation Resolution", (float) Automation_Block);
+		
+		result->setProperty("splitsPerBlock", interval > 0 ? juce::jlimit(1, numSteps, blockSize / interval) : 1);
+		addAutomationCounts(*result, automationCounts);
+		
+		return result;
+	}
+	
+	// The same sweep as runAutomationCase(), moved once per block, with each
+	// smoothing granularity gliding the coefficients across the block.
+	juce::var runSmoothingCase (AwesomeEQAudioProcessor& processor, SmoothingMode smoothing, double seconds)
+	{
+		constexpr double sampleRate = 48000.0;
+		constexpr int blockSize = 256;
+		
+		setParameter(processor, "Lowcut Freq", 80.f);
+		setParameter(processor, "Highcut Freq", 12000.f);
+		setParameter(processor, getBandParameterIDs(0).freq, 1000.f);
+		setParameter(processor, getBandParameterIDs(0).gain, 6.f);
+		setParameter(processor, "Lowcut Slope", (float) Slope_24);
+		setParameter(processor, "Highcut Slope", (float) Slope_24);
+		setParameter(processor, "Oversampling", (float) Oversampling_Off);
+		setParameter(processor, "Automation Resolution", (float) Automation_Block);
+		setParameter(processor, "Smoothing", (float) smoothing);
+		
+		processor.releaseResources();
+		processor.setPlayConfigDetails(numChannels, numChannels, sampleRate, blockSize);
+		processor.prepareToPlay(sampleRate, blockSize);
+		
+		RealtimeChecks::Counts automationCounts;
+		Noise noise;
+		
+		auto* result = timeProcessBlock(processor, sampleRate, blockSize, numChannels, seconds, 0, [&] (auto& buffer, int block)
+		{
+			noise(buffer, block);
+			
+			const auto phase = std::sin(juce::MathConstants<double>::twoPi * 4.0 * block * blockSize / sampleRate);
+			
+			{
+				const RealtimeChecks::Scope scope (automationCounts);
+				setParameter(processor, getBandParameterIDs(0).freq, (float) (1000.0 + 800.0 * phase));
+			}
+			
+			juce::Thread::sleep(1);
+		});
+		
+		setParameter(processor, "Smoothing", (float) Smoothing_Off);
+		
+		result->setProperty("smoothing", juce::StringArray { "off", "64 samples", "16 samples", "per sample" }[(int) smoothing]);
+		result->setProperty("interval", getSmoothingInterval(smoothing));
+		addAutomationCounts(*result, automationCounts);
+		
+		return result;
+	}
+	
+	juce::var runTrajectoryDesignCase (int numSteps, double sampleRate)
+	{
+		constexpr int numMoves = 2000;
+		
+		// The design thread's side of a split: one cached design per step, for a
+		// band sweep that only moves the one stage, as designFilters() does it.
+		ChannelSettings start, end;
+		start.lowCutFreq = end.lowCutFreq = 80.f;
+		start.highCutFreq = end.highCutFreq = 12000.f;
+		start.bands[0].enabled = end.bands[0].enabled = true;
+		start.bands[0].gainInDecibels = end.bands[0].gainInDecibels = 6.f;
+		
+		CoefficientCache cache;
+		DesignTrajectory trajectory;
+		double sink = 0.0;
+		const auto startTicks = juce::Time::getHighResolutionTicks();
+		
+		for (int move = 0; move < numMoves; ++move)
+		{
+			start.bands[0].freq = 200.f + (float) (move % 1000);
+			end.bands[0].freq = start.bands[0].freq + 37.f;
+			trajectory.numSteps = numSteps;
+			
+			for (int step = 0; step < numSteps; ++step)
+				trajectory.steps[(size_t) step] = cache.makeChainCoefficients(interpolateSettings(start, end, (float) (step + 1) / (float) numSteps), sampleRate);
+			
+			sink += trajectory.getFinal().bands[0][0];
+		}
+		
+		juce::ignoreUnused(sink);
+		
+		auto* result = new juce::DynamicObject();
+		result->setProperty("steps", numSteps);
+		result->setProperty("sampleRate", sampleRate);
+		result->setProperty("nsPerTrajectory", juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks) * 1.0e9 / numMoves);
+		result->setProperty("cacheHitRate", cache.getStatistics().getHitRate());
+		
+		return result;
+	}
+	
+	juce::var runBandsCase (AwesomeEQAudioProcessor& processor, int numBands, double seconds)
+	{
+		constexpr double sampleRate = 48000.0;
+		constexpr int blockSize = 256;
+		
+		// The first numBands bands boosted at their default frequencies, the rest
+		// disabled, with 12 dB/Oct cuts so the bands make up most of the cascade.
+		for (int band = 0; band < maxNumBands; ++band)
+		{
+			setParameter(processor, getBandParameterIDs(band).enabled, band < numBands ? 1.f : 0.f);
+			setParameter(processor, getBandParameterIDs(band).gain, band < numBands ? 3.f : 0.f);
+		}
+		
+		setParameter(processor, "Lowcut Freq", 40.f);
+		setParameter(processor, "Highcut Freq", 16000.f);
+		setParameter(processor, "Lowcut Slope", (float) Slope_12);
+		setParameter(processor, "Highcut Slope", (float) Slope_12);
+		setParameter(processor, "Oversampling", (float) Oversampling_Off);
+		
+		processor.releaseResources();
+		processor.setPlayConfigDetails(numChannels, numChannels, sampleRate, blockSize);
+		processor.prepareToPlay(sampleRate, blockSize);
+		
+		auto* result = timeProcessBlock(processor, sampleRate, blockSize, numChannels, seconds, 0, Noise());
+		
+		const auto sections = processor.getMetrics().numActiveSections;
+		
+		// Back to the default of a single enabled band for whatever runs next.
+		for (int band = 0; band < maxNumBands; ++band)
+		{
+			setParameter(processor, getBandParameterIDs(band).enabled, band == 0 ? 1.f : 0.f);
+			setParameter(processor, getBandParameterIDs(band).gain, 0.f);
+		}
+		
+		result->setProperty("enabledBands", numBands);
+		result->setProperty("activeSections", sections);
+		
+		return result;
+	}
+	
+	juce::var runStreamsCase (int numStreams, double seconds)
+	{
+		constexpr double sampleRate = 48000.0;
+		constexpr int blockSize = 256;
+		
+		juce::Random random (numStreams);
+		std::vector<ChannelSettings> streamSettings;
+		
+		for (int i = 0; i < numStreams; ++i)
+			streamSettings.push_back(makeRandomSettings(random));
+		
+		const auto numBlocks = juce::jmax(1, (int) (seconds * sampleRate) / blockSize);
+		const auto audioSeconds = numBlocks * blockSize / sampleRate;
+		
+		juce::AudioBuffer<float> buffer (numStreams, blockSize);
+		
+		auto fillWithNoise = [&]
+		{
+			for (int stream = 0; stream < numStreams; ++stream)
+				for (int i = 0; i < blockSize; ++i)
+					buffer.setSample(stream, i, random.nextFloat() * 2.f - 1.f);
+		};
+		
+		// Every stream in one batched engine, packed across the SIMD lanes.
+		MultiStreamEQ engine;
+		engine.prepare(sampleRate, numStreams);
+		
+		for (int stream = 0; stream < numStreams; ++stream)
+			engine.setStreamSettings(stream, streamSettings[(size_t) stream]);
+		
+		juce::int64 engineTicks = 0;
+		RealtimeChecks::Counts counts;
+		
+		for (int block = 0; block < numBlocks; ++block)
+		{
+			fillWithNoise();
+			const auto start = juce::Time::getHighResolutionTicks();
+			
+			{
+				const RealtimeChecks::Scope scope (counts);
+				engine.process(buffer.getArrayOfWritePointers(), blockSize);
+			}
+			
+			engineTicks += juce::Time::getHighResolutionTicks() - start;
+		}
+		
+		// The same streams as one mono processor instance each.
+		std::vector<std::unique_ptr<AwesomeEQAudioProcessor>> processors;
+		
+		for (int stream = 0; stream < numStreams; ++stream)
+		{
+			auto& processor = *processors.emplace_back(std::make_unique<AwesomeEQAudioProcessor>());
+			setChannelSettings(processor, streamSettings[(size_t) stream]);
+			processor.setPlayConfigDetails(1, 1, sampleRate, blockSize);
+			processor.prepareToPlay(sampleRate, blockSize);
+		}
+		
+		juce::MidiBuffer midiMessages;
+		juce::int64 processorTicks = 0;
+		
+		for (int block = 0; block < numBlocks; ++block)
+		{
+			fillWithNoise();
+			const auto start = juce::Time::getHighResolutionTicks();
+			
+			for (int stream = 0; stream < numStreams; ++stream)
+			{
+				juce::AudioBuffer<float> streamBuffer (buffer.getArrayOfWritePointers() + stream, 1, blockSize);
+				processors[(size_t) stream]->processBlock(streamBuffer, midiMessages);
+			}
+			
+			processorTicks += juce::Time::getHighResolutionTicks() - start;
+		}
+		
+		// Realtime streams one core could keep up with, from the time spent per second of audio.
+		auto getStreamsPerCore = [&] (juce::int64 ticks)
+		{
+			const auto elapsed = juce::Time::highResolutionTicksToSeconds(ticks);
+			return elapsed > 0.0 ? numStreams * audioSeconds / elapsed : 0.0;
+		};
+		
+		const auto engineStreamsPerCore = getStreamsPerCore(engineTicks);
+		const auto processorStreamsPerCore = getStreamsPerCore(processorTicks);
+		
+		auto* result = new juce::DynamicObject();
+		result->setProperty("streams", numStreams);
+		result->setProperty("sampleRate", sampleRate);
+		result->setProperty("blockSize", blockSize);
+		result->setProperty("streamsPerGroup", MultiStreamEQ::streamsPerGroup);
+		result->setProperty("engineStreamsPerCore", engineStreamsPerCore);
+		result->setProperty("processorStreamsPerCore", processorStreamsPerCore);
+		result->setProperty("speedup", processorStreamsPerCore > 0.0 ? engineStreamsPerCore / processorStreamsPerCore : 0.0);
+		result->setProperty("allocations", counts.allocations);
+		result->setProperty("deallocations", counts.deallocations);
+		result->setProperty("locks", counts.locks);
+		
+		return result;
+	}
+	
+	// The serial path an offline render would otherwise take: the processor in
+	// double precision, in large blocks. Returns the seconds it took.
+	double renderSerially (AwesomeEQAudioProcessor& processor, double sampleRate, const juce::AudioBuffer<float>& input,
+						   juce::AudioBuffer<float>& output)
+	{
+		constexpr int blockSize = 8192;
+		
+		setParameter(processor, "Oversampling", (float) Oversampling_Off);
+		setParameter(processor, "Filter Precision", (float) Precision_Double);
+		
+		processor.releaseResources();
+		processor.setPlayConfigDetails(numChannels, numChannels, sampleRate, blockSize);
+		processor.prepareToPlay(sampleRate, blockSize);
+		
+		output.makeCopyOf(input);
+		juce::MidiBuffer midiMessages;
+		juce::int64 totalTicks = 0;
+		
+		for (int position = 0; position < output.getNumSamples(); position += blockSize)
+		{
+			const auto numSamples = juce::jmin(blockSize, output.getNumSamples() - position);
+			juce::AudioBuffer<float> block (output.getArrayOfWritePointers(), numChannels, position, numSamples);
+			
+			const auto start = juce::Time::getHighResolutionTicks();
+			processor.processBlock(block, midiMessages);
+			totalTicks += juce::Time::getHighResolutionTicks() - start;
+		}
+		
+		processor.releaseResources();
+		setParameter(processor, "Filter Precision", (float) Precision_Float);
+		
+		return juce::Time::highResolutionTicksToSeconds(totalTicks);
+	}
+	
+	juce::var runParallelOfflineCase (const ChainCoefficients& chainCoefficients, const juce::AudioBuffer<float>& input,
+									  const juce::AudioBuffer<float>& reference, int numThreads)
+	{
+		const auto numSamples = input.getNumSamples();
+		
+		// The render tool's segments, a chunk per thread.
+		const auto segmentLength = numThreads * BlockParallelCascade::preferredChunkLength;
+		
+		BlockParallelCascade cascade;
+		cascade.prepare(numChannels, segmentLength);
+		cascade.setChain(chainCoefficients);
+		
+		juce::ThreadPool pool (numThreads);
+		juce::AudioBuffer<float> output;
+		output.makeCopyOf(input);
+		
+		const auto start = juce::Time::getHighResolutionTicks();
+		
+		for (int position = 0; position < numSamples; position += segmentLength)
+		{
+			float* channels[numChannels];
+			
+			for (int channel = 0; channel < numChannels; ++channel)
+				channels[channel] = output.getWritePointer(channel, position);
+			
+			cascade.process(channels, numChannels, juce::jmin(segmentLength, numSamples - position), pool, numThreads);
+		}
+		
+		const auto elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+		
+		double maxError = 0.0;
+		int numSamplesDiffering = 0;
+		
+		for (int channel = 0; channel < numChannels; ++channel)
+		{
+			for (int i = 0; i < numSamples; ++i)
+			{
+				const auto error = std::abs((double) output.getSample(channel, i) - (double) reference.getSample(channel, i));
+				maxError = juce::jmax(maxError, error);
+				numSamplesDiffering += error > 0.0 ? 1 : 0;
+			}
+		}
+		
+		auto* result = new juce::DynamicObject();
+		result->setProperty("threads", numThreads);
+		result->setProperty("sections", cascade.getNumSections());
+		result->setProperty("seconds", elapsed);
+		result->setProperty("maxErrorVsSerial", maxError);
+		result->setProperty("samplesDiffering", numSamplesDiffering);
+		
+		return result;
+	}
+	
+	// Band one as a static bell, then dynamic from the input and from a sidechain,
+	// which is the cost of replacing a compressor on the strip.
+	juce::var runDynamicsCase (AwesomeEQAudioProcessor& processor, DynamicsMode mode, double seconds)
+	{
+		constexpr double sampleRate = 48000.0;
+		constexpr int blockSize = 256;
+		
+		setParameter(processor, getBandParameterIDs(0).freq, 3000.f);
+		setParameter(processor, getBandParameterIDs(0).gain, 3.f);
+		setParameter(processor, "Band1 Dynamics", (float) mode);
+		setParameter(processor, "Band1 Dynamics Threshold", -30.f);
+		setParameter(processor, "Band1 Dynamics Ratio", 4.f);
+		setParameter(processor, "Oversampling", (float) Oversampling_Off);
+		
+		auto layout = processor.getBusesLayout();
+		layout.inputBuses.getReference(1) = mode == Dynamics_Sidechain ? juce::AudioChannelSet::stereo() : juce::AudioChannelSet::disabled();
+		
+		processor.releaseResources();
+		processor.setBusesLayout(layout);
+		processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+		processor.prepareToPlay(sampleRate, blockSize);
+		
+		// Band one's table comes from the design thread. Waiting for it means every
+		// timed block is dynamic; the static case has nothing to wait for.
+		const auto numBufferChannels = juce::jmax(processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels());
+		
+		if (mode != Dynamics_Off)
+			processUntilReady(processor, blockSize, numBufferChannels, [&] { return processor.isBandOneDynamic(); });
+		
+		auto* result = timeProcessBlock(processor, sampleRate, blockSize, numBufferChannels, seconds, 0, Noise());
+		
+		processor.releaseResources();
+		layout.inputBuses.getReference(1) = juce::AudioChannelSet::disabled();
+		processor.setBusesLayout(layout);
+		setParameter(processor, "Band1 Dynamics", (float) Dynamics_Off);
+		setParameter(processor, getBandParameterIDs(0).gain, 0.f);
+		
+		result->setProperty("mode", juce::StringArray { "static", "input", "sidechain" }[(int) mode]);
+		result->setProperty("controlInterval", DynamicBand::controlInterval);
+		
+		return result;
+	}
+	
+	// The chain with metering off, metering on, and analysis alone, which
+	// measures the input and skips the chain. Two bands are measured.
+	juce::var runMeteringCase (AwesomeEQAudioProcessor& processor, MeteringMode mode, double seconds)
+	{
+		constexpr double sampleRate = 48000.0;
+		constexpr int blockSize = 256;
+		
+		setParameter(processor, getBandParameterIDs(0).gain, 3.f);
+		setParameter(processor, getBandParameterIDs(1).enabled, 1.f);
+		setParameter(processor, getBandParameterIDs(1).gain, -3.f);
+		setParameter(processor, "Metering", (float) mode);
+		setParameter(processor, "Oversampling", (float) Oversampling_Off);
+		
+		processor.releaseResources();
+		processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+		processor.prepareToPlay(sampleRate, blockSize);
+		
+		// The meter's band filters come from the design thread; wait until both
+		// bands are measured, so every timed block measures them, then start the
+		// readings again from the first timed block.
+		const auto numBufferChannels = processor.getTotalNumOutputChannels();
+		
+		if (mode != Metering_Off)
+		{
+			processUntilReady(processor, blockSize, numBufferChannels, [&]
+			{
+				const auto measuredBands = processor.getMeterReadings().measuredBands;
+				return measuredBands[0] && measuredBands[1];
+			});
+			
+			processor.resetMeters();
+		}
+		
+		auto* result = timeProcessBlock(processor, sampleRate, blockSize, numBufferChannels, seconds, 0, Noise());
+		
+		const auto readings = processor.getMeterReadings();
+		
+		processor.releaseResources();
+		setParameter(processor, "Metering", (float) Metering_Off);
+		setParameter(processor, getBandParameterIDs(1).enabled, 0.f);
+		setParameter(processor, getBandParameterIDs(1).gain, 0.f);
+		setParameter(processor, getBandParameterIDs(0).gain, 0.f);
+		
+		result->setProperty("mode", juce::StringArray { "off", "on", "analysisOnly" }[(int) mode]);
+		
+		if (mode != Metering_Off)
+			result->setProperty("readings", readings.toVar());
+		
+		return result;
+	}
+	
+	// What each instance in a large session costs to create and prepare: time,
+	// and the heap it keeps, which with sizeof included is its whole footprint.
+	// The caller keeps one instance alive throughout, so the design thread and
+	// coefficient cache all instances share are already there, as they would be
+	// after the first instance of a session.
+	juce::var runInstantiationCase (int numInstances, PhaseMode phase)
+	{
+		constexpr double sampleRate = 48000.0;
+		constexpr int blockSize = 512;
+		
+		std::vector<std::unique_ptr<AwesomeEQAudioProcessor>> processors;
+		processors.reserve((size_t) numInstances);
+		
+		RealtimeChecks::Counts constructCounts, prepareCounts;
+		juce::int64 constructTicks = 0, prepareTicks = 0;
+		
+		for (int i = 0; i < numInstances; ++i)
+		{
+			const auto start = juce::Time::getHighResolutionTicks();
+			
+			{
+				const RealtimeChecks::Scope scope (constructCounts);
+				processors.push_back(std::make_unique<AwesomeEQAudioProcessor>());
+			}
+			
+			constructTicks += juce::Time::getHighResolutionTicks() - start;
+		}
+		
+		for (auto& processor : processors)
+		{
+			setParameter(*processor, "Phase", (float) phase);
+			processor->setPlayConfigDetails(numChannels, numChannels, sampleRate, blockSize);
+			
+			const auto start = juce::Time::getHighResolutionTicks();
+			
+			{
+				const RealtimeChecks::Scope scope (prepareCounts);
+				processor->prepareToPlay(sampleRate, blockSize);
+			}
+			
+			prepareTicks += juce::Time::getHighResolutionTicks() - start;
+		}
+		
+		auto perInstance = [&] (juce::int64 value) { return (double) value / numInstances; };
+		auto getMicroseconds = [&] (juce::int64 ticks) { return juce::Time::highResolutionTicksToSeconds(ticks) * 1.0e6 / numInstances; };
+		
+		const auto constructBytes = perInstance(constructCounts.allocatedBytes - constructCounts.deallocatedBytes);
+		const auto prepareBytes = perInstance(prepareCounts.allocatedBytes - prepareCounts.deallocatedBytes);
+		
+		auto* result = new juce::DynamicObject();
+		result->setProperty("instances", numInstances);
+		result->setProperty("phase", phase == Phase_Linear ? "linear" : "minimum");
+		result->setProperty("sampleRate", sampleRate);
+		result->setProperty("blockSize", blockSize);
+		result->setProperty("objectBytes", (int) sizeof(AwesomeEQAudioProcessor));
+		result->setProperty("constructMicroseconds", getMicroseconds(constructTicks));
+		result->setProperty("prepareMicroseconds", getMicroseconds(prepareTicks));
+		result->setProperty("constructBytes", constructBytes);
+		result->setProperty("prepareBytes", prepareBytes);
+		result->setProperty("bytesPerInstance", constructBytes + prepareBytes);
+		result->setProperty("constructAllocations", perInstance(constructCounts.allocations));
+		result->setProperty("prepareAllocations", perInstance(prepareCounts.allocations));
+		
+		return result;
+	}
+	
+	// A session being reopened: one non-default state, saved once and restored
+	// into fresh instances before they're prepared, the way a host loads them.
+	// Every parameter should come back exactly, and each instance should design
+	// its chain once, for the prepared rate, rather than once per restored value.
+	juce::var runStateRestoreCase (int numInstances)
+	{
+		constexpr double sampleRate = 48000.0;
+		constexpr int blockSize = 512;
+		
+		AwesomeEQAudioProcessor source;
+		setParameter(source, "Lowcut Freq", 120.f);
+		setParameter(source, "Lowcut Slope", (float) Slope_36);
+		setParameter(source, "Highcut Freq", 9000.f);
+		setParameter(source, "Highcut Slope", (float) Slope_24);
+		setParameter(source, "Band1 Gain", -4.5f);
+		setParameter(source, "Band1 Quality", 2.5f);
+		setParameter(source, "Band3 Enabled", 1.f);
+		setParameter(source, "Band3 Gain", 6.f);
+		setParameter(source, "Band8 Enabled", 1.f);
+		setParameter(source, "Band8 Gain", -3.f);
+		setParameter(source, "Band1 Dynamics Threshold", -30.f);
+		
+		juce::MemoryBlock state;
+		source.getStateInformation(state);
+		
+		std::vector<std::unique_ptr<AwesomeEQAudioProcessor>> processors;
+		processors.reserve((size_t) numInstances);
+		
+		for (int i = 0; i < numInstances; ++i)
+			processors.push_back(std::make_unique<AwesomeEQAudioProcessor>());
+		
+		juce::int64 restoreTicks = 0, prepareTicks = 0;
+		
+		for (auto& processor : processors)
+		{
+			auto start = juce::Time::getHighResolutionTicks();
+			processor->setStateInformation(state.getData(), (int) state.getSize());
+			restoreTicks += juce::Time::getHighResolutionTicks() - start;
+			
+			processor->setPlayConfigDetails(numChannels, numChannels, sampleRate, blockSize);
+			
+			start = juce::Time::getHighResolutionTicks();
+			processor->prepareToPlay(sampleRate, blockSize);
+			prepareTicks += juce::Time::getHighResolutionTicks() - start;
+		}
+		
+		// The design after prepareToPlay() runs on the shared design thread, so
+		// wait for every instance's, then leave time for any extra ones to land.
+		auto allDesigned = [&]
+		{
+			return std::all_of(processors.begin(), processors.end(), [] (const auto& processor) { return processor->getMetrics().numDesigns > 0; });
+		};
+		
+		const auto timeout = juce::Time::getMillisecondCounter() + 5000;
+		
+		while (! allDesigned() && juce::Time::getMillisecondCounter() < timeout)
+			juce::Thread::sleep(1);
+		
+		juce::Thread::sleep(50);
+		
+		int mismatchedParameters = 0, instancesWithExtraDesigns = 0, instancesWithoutDesign = 0;
+		juce::int64 totalDesigns = 0;
+		
+		for (auto& processor : processors)
+		{
+			for (auto* parameter : source.getParameters())
+				if (auto* expected = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+				{
+					auto* restored = processor->parameters.getParameter(expected->paramID);
+					
+					if (restored == nullptr || restored->convertFrom0to1(restored->getValue()) != expected->convertFrom0to1(expected->getValue()))
+						++mismatchedParameters;
+				}
+			
+			const auto numDesigns = processor->getMetrics().numDesigns;
+			totalDesigns += numDesigns;
+			
+			if (numDesigns == 0)
+				++instancesWithoutDesign;
+			else if (numDesigns > 1)
+				++instancesWithExtraDesigns;
+		}
+		
+		auto getMicroseconds = [&] (juce::int64 ticks) { return juce::Time::highResolutionTicksToSeconds(ticks) * 1.0e6 / numInstances; };
+		
+		auto* result = new juce::DynamicObject();
+		result->setProperty("instances", numInstances);
+		result->setProperty("sampleRate", sampleRate);
+		result->setProperty("blockSize", blockSize);
+		result->setProperty("stateBytes", (int) state.getSize());
+		result->setProperty("restoreMicroseconds", getMicroseconds(restoreTicks));
+		result->setProperty("prepareMicroseconds", getMicroseconds(prepareTicks));
+		result->setProperty("mismatchedParameters", mismatchedParameters);
+		result->setProperty("designsPerInstance", (double) totalDesigns / numInstances);
+		result->setProperty("instancesWithExtraDesigns", instancesWithExtraDesigns);
+		result->setProperty("instancesWithoutDesign", instancesWithoutDesign);
+		
+		return result;
+	}
+	
+	enum class Signal
+	{
+		noise,
+		silence
+	};
+	
+	juce::var runSilenceCase (AwesomeEQAudioProcessor& processor, double sampleRate, Signal signal, bool neutral, double seconds)
+	{
+		constexpr int blockSize = 256;
+		
+		// Neutral is the default state of every band; otherwise all three stages are active.
+		setParameter(processor, "Lowcut Freq", neutral ? 20.f : 80.f);
+		setParameter(processor, "Highcut Freq", neutral ? 20000.f : 12000.f);
+		setParameter(processor, getBandParameterIDs(0).freq, 1000.f);
+		setParameter(processor, getBandParameterIDs(0).gain, neutral ? 0.f : 6.f);
+		setParameter(processor, "Lowcut Slope", (float) Slope_48);
+		setParameter(processor, "Highcut Slope", (float) Slope_48);
+		setParameter(processor, "Oversampling", (float) Oversampling_Off);
+		
+		processor.releaseResources();
+		processor.setPlayConfigDetails(numChannels, numChannels, sampleRate, blockSize);
+		processor.prepareToPlay(sampleRate, blockSize);
+		
+		Noise noise;
+		
+		// A second of warm-up is well past the ring-down, so silence has put the filters to sleep.
+		auto* result = timeProcessBlock(processor, sampleRate, blockSize, numChannels, seconds, juce::jmax(8, (int) sampleRate / blockSize), [&] (auto& buffer, int block)
+		{
+			if (signal == Signal::noise)
+				noise(buffer, block);
+			else
+				buffer.clear();
+		});
+		
+		result->setProperty("input", signal == Signal::noise ? "noise" : "silence");
+		result->setProperty("bands", neutral ? "neutral" : "active");
+		
+		return result;
+	}
+	
+	juce::var getCacheStatistics (const CoefficientCache::Statistics& statistics)
+	{
+		auto* result = new juce::DynamicObject();
+		result->setProperty("hits", statistics.hits);
+		result->setProperty("misses", statistics.misses);
+		result->setProperty("hitRate", statistics.getHitRate());
+		result->setProperty("slotsUsed", statistics.numSlotsUsed);
+		result->setProperty("slots", statistics.numSlots);
+		result->setProperty("bytes", (juce::int64) statistics.memoryFootprintInBytes);
+		
+		return result;
+	}
+}
+
+juce::var Benchmark::run (const Options& options)
+{
+	AwesomeEQAudioProcessor processor;
+	juce::Array<juce::var> processResults, baselineResults, designResults, oversamplingResults, peakAccuracyResults, precisionResults, silenceResults, automationResults, smoothingResults, trajectoryResults, bandResults, streamResults, parallelResults, instantiationResults, dynamicsResults, meteringResults;
+	
+	for (auto sampleRate : sampleRates)
+		for (auto blockSize : blockSizes)
+			for (auto slope : { Slope_12, Slope_24, Slope_36, Slope_48 })
+				for (auto automated : { false, true })
+					processResults.add(runCase(processor, sampleRate, blockSize, slope, automated, Oversampling_Off, options.secondsPerCase));
+	
+	// The SIMD cascade against the scalar filter chains it replaced.
+	for (auto blockSize : { 64, 256, 1024 })
+		baselineResults.add(runCascadeBaselineCase(48000.0, blockSize, options.secondsPerCase));
+	
+	// The two ways of getting an accurate peak near Nyquist at the base rates:
+	// what oversampling costs per sample, against how close a matched design
+	// gets without it. A matched peak runs at exactly the 1x cost.
+	for (auto sampleRate : { 44100.0, 48000.0 })
+	{
+		for (auto oversampling : { Oversampling_Off, Oversampling_2x, Oversampling_4x })
+			oversamplingResults.add(runCase(processor, sampleRate, 256, Slope_12, false, oversampling, options.secondsPerCase));
+		
+		for (auto peakFreq : { 1000.f, 10000.f, 15000.f, 18000.f })
+			peakAccuracyResults.add(runPeakAccuracyCase(sampleRate, peakFreq));
+	}
+	
+	// Float, mixed (float audio through double state) and double, each compared
+	// against the double output for the same input.
+	for (auto sampleRate : { 48000.0, 96000.0, 192000.0 })
+	{
+		std::vector<double> reference;
+		precisionResults.add(runPrecisionCase<double>(processor, sampleRate, Precision_Double, options.secondsPerCase, reference));
+		precisionResults.add(runPrecisionCase<float>(processor, sampleRate, Precision_Float, options.secondsPerCase, reference));
+		precisionResults.add(runPrecisionCase<float>(processor, sampleRate, Precision_Double, options.secondsPerCase, reference));
+	}
+	
+	// What silence detection and the neutral bypass save, against the full
+	// chain running on noise.
+	for (auto sampleRate : { 48000.0, 96000.0 })
+	{
+		auto active = runSilenceCase(processor, sampleRate, Signal::noise, false, options.secondsPerCase);
+		const auto activeNsPerSample = (double) active["nsPerSample"];
+		silenceResults.add(active);
+		
+		for (auto idle : { runSilenceCase(processor, sampleRate, Signal::silence, false, options.secondsPerCase),
+						   runSilenceCase(processor, sampleRate, Signal::noise, true, options.secondsPerCase) })
+		{
+			if (auto* result = idle.getDynamicObject())
+				result->setProperty("cpuSaved", activeNsPerSample > 0.0 ? 1.0 - (double) idle["nsPerSample"] / activeNsPerSample : 0.0);
+			
+			silenceResults.add(idle);
+		}
+	}
+	
+	// Splitting blocks to follow automation: the audio thread's cost per sample
+	// against the number of splits, and the design thread's cost per step.
+	for (auto blockSize : { 256, 2048, 4096 })
+	{
+		auto perBlock = runAutomationCase(processor, blockSize, Automation_Block, options.secondsPerCase);
+		const auto perBlockNsPerSample = (double) perBlock["nsPerSample"];
+		automationResults.add(perBlock);
+		
+		for (auto split : { runAutomationCase(processor, blockSize, Automation_128, options.secondsPerCase),
+							runAutomationCase(processor, blockSize, Automation_32, options.secondsPerCase) })
+		{
+			if (auto* result = split.getDynamicObject())
+				result->setProperty("overhead", perBlockNsPerSample > 0.0 ? (double) split["nsPerSample"] / perBlockNsPerSample - 1.0 : 0.0);
+			
+			automationResults.add(split);
+		}
+	}
+	
+	// Gliding towards each new design: the cost of every granularity against
+	// jumping straight to it.
+	{
+		auto unsmoothed = runSmoothingCase(processor, Smoothing_Off, options.secondsPerCase);
+		const auto unsmoothedNsPerSample = (double) unsmoothed["nsPerSample"];
+		smoothingResults.add(unsmoothed);
+		
+		for (auto smoothing : { Smoothing_64, Smoothing_16, Smoothing_PerSample })
+		{
+			auto smoothed = runSmoothingCase(processor, smoothing, options.secondsPerCase);
+			
+			if (auto* result = smoothed.getDynamicObject())
+				result->setProperty("overhead", unsmoothedNsPerSample > 0.0 ? (double) smoothed["nsPerSample"] / unsmoothedNsPerSample - 1.0 : 0.0);
+			
+			smoothingResults.add(smoothed);
+		}
+	}
+	
+	// Only enabled bands are packed into the cascade, so the cost should follow
+	// the number in use rather than the number available.
+	for (auto numBands : { 1, 2, 4, maxNumBands })
+		bandResults.add(runBandsCase(processor, numBands, options.secondsPerCase));
+	
+	// Many unrelated mono streams: one batched engine against a processor per stream.
+	for (auto numStreams : { 4, 16, 64, 256 })
+		streamResults.add(runStreamsCase(numStreams, options.secondsPerCase));
+	
+	// Offline rendering split into chunks across threads, against the serial
+	// processor in double precision on the same long file, for every thread count.
+	{
+		constexpr double sampleRate = 48000.0;
+		juce::Random random (22);
+		const auto channelSettings = makeRandomSettings(random);
+		setChannelSettings(processor, channelSettings);
+		
+		juce::AudioBuffer<float> input (numChannels, (int) (30.0 * options.secondsPerCase * sampleRate)), reference;
+		
+		for (int channel = 0; channel < numChannels; ++channel)
+			for (int i = 0; i < input.getNumSamples(); ++i)
+				input.setSample(channel, i, random.nextFloat() * 2.f - 1.f);
+		
+		const auto serialSeconds = renderSerially(processor, sampleRate, input, reference);
+		const auto chainCoefficients = makeChainCoefficients(channelSettings, sampleRate);
+		
+		juce::SortedSet<int> threadCounts;
+		
+		for (auto numThreads : { 1, 2, 4, 8, juce::SystemStats::getNumCpus() })
+			threadCounts.add(numThreads);
+		
+		double oneThreadSeconds = 0.0;
+		
+		for (auto numThreads : threadCounts)
+		{
+			auto result = runParallelOfflineCase(chainCoefficients, input, reference, numThreads);
+			const auto seconds = (double) result["seconds"];
+			
+			if (numThreads == 1)
+				oneThreadSeconds = seconds;
+			
+			if (auto* object = result.getDynamicObject())
+			{
+				object->setProperty("audioSeconds", input.getNumSamples() / sampleRate);
+				object->setProperty("serialSeconds", serialSeconds);
+				object->setProperty("speedup", seconds > 0.0 ? oneThreadSeconds / seconds : 0.0);
+				object->setProperty("speedupVsSerial", seconds > 0.0 ? serialSeconds / seconds : 0.0);
+			}
+			
+			parallelResults.add(result);
+		}
+		
+		for (auto* parameter : processor.getParameters())
+			parameter->setValueNotifyingHost(parameter->getDefaultValue());
+	}
+	
+	// A dynamic band one against the same band static.
+	{
+		auto staticBand = runDynamicsCase(processor, Dynamics_Off, options.secondsPerCase);
+		const auto staticNsPerSample = (double) staticBand["nsPerSample"];
+		dynamicsResults.add(staticBand);
+		
+		for (auto mode : { Dynamics_Input, Dynamics_Sidechain })
+		{
+			auto dynamic = runDynamicsCase(processor, mode, options.secondsPerCase);
+			
+			if (auto* result = dynamic.getDynamicObject())
+				result->setProperty("overhead", staticNsPerSample > 0.0 ? (double) dynamic["nsPerSample"] / staticNsPerSample - 1.0 : 0.0);
+			
+			dynamicsResults.add(dynamic);
+		}
+	}
+	
+	// Metering on, and analysis alone, each timed against the chain unmetered
+	// and reported as a relative overhead. Analysis alone skips the chain, so
+	// its overhead should come out negative.
+	{
+		auto unmetered = runMeteringCase(processor, Metering_Off, options.secondsPerCase);
+		const auto unmeteredNsPerSample = (double) unmetered["nsPerSample"];
+		meteringResults.add(unmetered);
+		
+		for (auto mode : { Metering_On, Metering_AnalysisOnly })
+		{
+			auto metered = runMeteringCase(processor, mode, options.secondsPerCase);
+			
+			if (auto* result = metered.getDynamicObject())
+				result->setProperty("overhead", unmeteredNsPerSample > 0.0 ? (double) metered["nsPerSample"] / unmeteredNsPerSample - 1.0 : 0.0);
+			
+			meteringResults.add(metered);
+		}
+	}
+	
+	// Sessions with hundreds of instances: what each one costs to load. Only
+	// instances set to linear phase should pay for the convolver.
+	for (auto phase : { Phase_Minimum, Phase_Linear })
+		instantiationResults.add(runInstantiationCase(64, phase));
+	
+	const auto stateRestoreResult = runStateRestoreCase(1000);
+	
+	for (auto numSteps : { 1, 2, 4, 8, 16, 32 })
+		trajectoryResults.add(runTrajectoryDesignCase(numSteps, 48000.0));
+	
+	for (auto slope : { Slope_12, Slope_24, Slope_36, Slope_48 })
+		designResults.add(runDesignCase(slope, 48000.0));
+	
+	auto* results = new juce::DynamicObject();
+	results->setProperty("plugin", JucePlugin_Name);
+	results->setProperty("time", juce::Time::getCurrentTime().toISO8601(true));
+	results->setProperty("cpu", juce::SystemStats::getCpuModel());
+	results->setProperty("instructionSet", BiquadCascade<float>::getInstructionSetName());
+	results->setProperty("realtimeChecks", RealtimeChecks::isAvailable());
+	results->setProperty("processBlock", processResults);
+	results->setProperty("cascadeBaseline", baselineResults);
+	results->setProperty("design", designResults);
+	results->setProperty("oversampling", oversamplingResults);
+	results->setProperty("peakAccuracy", peakAccuracyResults);
+	results->setProperty("precision", precisionResults);
+	results->setProperty("silence", silenceResults);
+	results->setProperty("automation", automationResults);
+	results->setProperty("smoothing", smoothingResults);
+	results->setProperty("trajectoryDesign", trajectoryResults);
+	results->setProperty("bands", bandResults);
+	results->setProperty("streams", streamResults);
+	results->setProperty("parallelOffline", parallelResults);
+	results->setProperty("instantiation", instantiationResults);
+	results->setProperty("stateRestore", stateRestoreResult);
+	results->setProperty("dynamics", dynamicsResults);
+	results->setProperty("metering", meteringResults);
+	results->setProperty("coefficientCache", getCacheStatistics(processor.getCoefficientCacheStatistics()));
+	results->setProperty("lastCaseMetrics", processor.getMetrics().toVar());
+	
+	return results;
+}
+
+bool Benchmark::hasRealtimeViolations (const juce::var& results)
+{
+	for (auto* section : { "processBlock", "oversampling", "precision", "silence", "automation", "smoothing", "bands", "streams", "dynamics", "metering" })
+		if (auto* processResults = results[section].getArray())
+			for (auto& result : *processResults)
+				if ((juce::int64) result["allocations"] > 0 || (juce::int64) result["deallocations"] > 0 || (juce::int64) result["locks"] > 0
+					|| (juce::int64) result["automationAllocations"] > 0 || (juce::int64) result["automationDeallocations"] > 0)
+					return true;
+	
+	return false;
+}
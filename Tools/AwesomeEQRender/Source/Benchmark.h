@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    Benchmark.h
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Times AwesomeEQAudioProcessor::processBlock across sample rates, block sizes
+    and slopes, with static and automated parameters, plus the cost of a full
+    coefficient design with and without the coefficient cache. Allocations and
+    locks inside processBlock are counted through RealtimeChecks, as are those
+    of the parameter changes in automated cases, which hosts send on the audio
+    thread. JUCE's own parameter listener lists lock on every change, so those
+    locks are reported as automationLocks rather than failing the run.
+
+    The SIMD biquad cascade is timed against the two scalar IIR::Filter chains
+    it replaced, on the same nine-section design, as a speed-up.
+
+    For peaks near Nyquist it also weighs 2x/4x oversampling against a
+    matched (Vicanek) peak design: the processing cost of each oversampling
+    factor, and each design's worst deviation from the analog curve.
+
+    Float, mixed and double precision processing are timed side by side and
+    compared with the double output for the same input.
+
+    The idle paths are timed against the full chain on noise: silent input,
+    once the filters have gone to sleep, and neutral bands, which bypass them.
+
+    Following automation with split blocks is timed against one design per
+    block, over the block sizes where the splits matter, along with what each
+    extra step costs the design thread.
+
+    Each coefficient smoothing granularity, from 64 samples down to every
+    sample, is timed under a moving band against no smoothing at all.
+
+    The chain is also timed with one, two, four and all of its bands enabled,
+    to show the cost follows the bands in use.
+
+    For many independent streams, MultiStreamEQ is timed against one processor
+    instance per stream, as realtime streams per core.
+
+    Offline rendering through BlockParallelCascade is timed by thread count on
+    a long file, with its speed-up and its deviation from the serial processor.
+
+    Band one is timed dynamic, keyed from the input and from a sidechain,
+    against the same band static.
+
+    Metering is timed against the unmetered chain, both alongside it and as
+    analysis alone, along with the readings each run ends on.
+
+    For large sessions, instances are created and prepared in bulk, reporting
+    the time each takes and the heap each instance keeps.
+    A saved state is also restored into a thousand fresh instances, timing the
+    restore and the prepare, and checking that every parameter comes back
+    exactly and that each instance designs its chain only once.
+
+    Results are returned as a JSON object so runs can be compared over time.
+*/
+namespace Benchmark
+{
+	struct Options
+	{
+		double secondsPerCase { 1.0 };
+	};
+	
+	juce::var run (const Options& options);
+	
+	/** True if the results show any allocation or lock inside processBlock, or
+		any allocation while automating a parameter.
+	*/
+	bool hasRealtimeViolations (const juce::var& results);
+}
@@ -0,0 +1,386 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for a JUCE application.
+
+    AwesomeEQRender streams audio files through AwesomeEQAudioProcessor
+    without a host or a display, one processor instance per worker thread.
+    With --parallel the files are rendered one at a time instead, each split
+    into chunks across the threads by BlockParallelCascade. With --benchmark it
+    times processBlock instead and reports JSON, and with --metrics each render
+    is followed by the processor's metrics as JSON. With --meter each render is
+    followed by the level meter's readings as JSON, and --analyse takes those
+    readings without filtering or writing anything.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+#include "Benchmark.h"
+#include "../../../Source/BlockParallelCascade.h"
+#include "../../../Source/PluginProcessor.h"
+
+namespace
+{
+	struct RenderSettings
+	{
+		juce::File outputDirectory;
+		juce::MemoryBlock state;
+		juce::StringPairArray parameterValues;
+		int blockSize { 8192 };
+		bool printMetrics { false };
+		bool printMeter { false };
+		bool analyseOnly { false };
+		bool parallel { false };
+	};
+	
+	// The chunked path only has the static minimum-phase chain at the host rate.
+	bool canRenderInParallel (AwesomeEQAudioProcessor& processor)
+	{
+		return static_cast<PhaseMode>(processor.parameters.getRawParameterValue("Phase")->load()) == Phase_Minimum
+			&& static_cast<OversamplingMode>(processor.parameters.getRawParameterValue("Oversampling")->load()) == Oversampling_Off
+			&& static_cast<DynamicsMode>(processor.parameters.getRawParameterValue("Band1 Dynamics")->load()) == Dynamics_Off
+			&& static_cast<MeteringMode>(processor.parameters.getRawParameterValue("Metering")->load()) == Metering_Off;
+	}
+	
+	void applySettings (AwesomeEQAudioProcessor& processor, const RenderSettings& settings)
+	{
+		if (settings.state.getSize() > 0)
+			processor.setStateInformation(settings.state.getData(), (int) settings.state.getSize());
+		
+		for (auto& parameterID : settings.parameterValues.getAllKeys())
+		{
+			if (auto* parameter = processor.parameters.getParameter(parameterID))
+				parameter->setValueNotifyingHost(parameter->convertTo0to1(settings.parameterValues[parameterID].getFloatValue()));
+			else
+				std::cerr << "Unknown parameter: " << parameterID << std::endl;
+		}
+		
+		// Asking for readings turns the meter on, unless the settings already have.
+		auto* metering = processor.parameters.getParameter("Metering");
+		const auto meteringMode = static_cast<MeteringMode>(processor.parameters.getRawParameterValue("Metering")->load());
+		
+		if (settings.analyseOnly)
+			metering->setValueNotifyingHost(metering->convertTo0to1((float) Metering_AnalysisOnly));
+		else if (settings.printMeter && meteringMode == Metering_Off)
+			metering->setValueNotifyingHost(metering->convertTo0to1((float) Metering_On));
+	}
+	
+	void printResults (AwesomeEQAudioProcessor& processor, const RenderSettings& settings)
+	{
+		if (settings.printMetrics)
+			std::cout << juce::JSON::toString(processor.getMetrics().toVar(), true) << std::endl;
+		
+		if (settings.printMeter || settings.analyseOnly)
+			std::cout << juce::JSON::toString(processor.getMeterReadings().toVar(), true) << std::endl;
+	}
+	
+	// Returns an error message, or an empty string on success. Given a pool, the
+	// file is filtered in parallel chunks on it, when the settings allow. Analysis
+	// only runs the file through the processor and writes nothing.
+	juce::String renderFile (AwesomeEQAudioProcessor& processor, juce::AudioFormatManager& formatManager,
+							 const juce::File& input, const RenderSettings& settings, juce::ThreadPool* pool = nullptr, int numThreads = 1)
+	{
+		std::unique_ptr<juce::AudioFormatReader> reader (formatManager.createReaderFor(input));
+		
+		if (reader == nullptr)
+			return "Can't read " + input.getFullPathName();
+		
+		auto output = settings.outputDirectory.getChildFile(input.getFileName());
+		std::unique_ptr<juce::AudioFormatWriter> writer;
+		
+		if (! settings.analyseOnly)
+		{
+			auto* format = formatManager.findFormatForFileExtension(input.getFileExtension());
+			output.deleteFile();
+			
+			auto stream = std::make_unique<juce::FileOutputStream>(output);
+			
+			if (format == nullptr || ! stream->openedOk())
+				return "Can't write " + output.getFullPathName();
+			
+			writer.reset(format->createWriterFor(stream.get(), reader->sampleRate, reader->numChannels,
+												 (int) reader->bitsPerSample, reader->metadataValues, 0));
+			
+			if (writer == nullptr)
+				return "No " + format->getFormatName() + " writer for " + input.getFileName();
+			
+			// The writer owns the stream from here on.
+			stream.release();
+		}
+		
+		const auto numChannels = (int) reader->numChannels;
+		
+		if (pool != nullptr && canRenderInParallel(processor))
+		{
+			// The same design the processor would run, with nothing to run when it
+			// would bypass a neutral curve. There's no latency to make up for.
+			const auto chainCoefficients = makeChainCoefficients(getChannelSettings(processor.parameters), reader->sampleRate);
+			const auto segmentLength = numThreads * BlockParallelCascade::preferredChunkLength;
+			
+			BlockParallelCascade cascade;
+			cascade.prepare(numChannels, segmentLength);
+			
+			if (! chainCoefficients.isNeutral)
+				cascade.setChain(chainCoefficients);
+			
+			juce::AudioBuffer<float> buffer (numChannels, segmentLength);
+			
+			for (juce::int64 position = 0; position < reader->lengthInSamples; position += segmentLength)
+			{
+				const auto numSamples = (int) juce::jmin((juce::int64) segmentLength, reader->lengthInSamples - position);
+				
+				buffer.setSize(numChannels, numSamples, false, false, true);
+				reader->read(&buffer, 0, numSamples, position, true, true);
+				cascade.process(buffer.getArrayOfWritePointers(), numChannels, numSamples, *pool, numThreads);
+				
+				if (! writer->writeFromAudioSampleBuffer(buffer, 0, numSamples))
+					return "Write failed for " + output.getFullPathName();
+			}
+			
+			return {};
+		}
+		
+		processor.releaseResources();
+		processor.setPlayConfigDetails(numChannels, numChannels, reader->sampleRate, settings.blockSize);
+		processor.prepareToPlay(reader->sampleRate, settings.blockSize);
+		
+		juce::AudioBuffer<float> buffer (numChannels, settings.blockSize);
+		juce::MidiBuffer midiMessages;
+		
+		// Run on past the end by the reported latency and drop that many samples
+		// from the start, so the output lines up with the input.
+		const auto latency = (juce::int64) processor.getLatencySamples();
+		const auto totalLength = reader->lengthInSamples + latency;
+		
+		for (juce::int64 position = 0; position < totalLength; position += settings.blockSize)
+		{
+			const auto numSamples = (int) juce::jmin((juce::int64) settings.blockSize, totalLength - position);
+			
+			buffer.setSize(numChannels, numSamples, false, false, true);
+			reader->read(&buffer, 0, numSamples, position, true, true);
+			processor.processBlock(buffer, midiMessages);
+			
+			const auto numToSkip = (int) juce::jlimit((juce::int64) 0, (juce::int64) numSamples, latency - position);
+			
+			if (writer != nullptr && numToSkip < numSamples && ! writer->writeFromAudioSampleBuffer(buffer, numToSkip, numSamples - numToSkip))
+				return "Write failed for " + output.getFullPathName();
+		}
+		
+		return {};
+	}
+	
+	//==============================================================================
+	// Each job owns one processor and keeps taking files off the shared list until it's empty.
+	class RenderJob  : public juce::ThreadPoolJob
+	{
+	public:
+		RenderJob (AwesomeEQAudioProcessor& p, const juce::Array<juce::File>& filesToRender, std::atomic<int>& next,
+				   const RenderSettings& s, std::atomic<int>& failures)
+			: juce::ThreadPoolJob("AwesomeEQ Render"),
+			  processor(p), files(filesToRender), nextFile(next), settings(s), numFailures(failures)
+		{
+		}
+		
+		JobStatus runJob() override
+		{
+			juce::AudioFormatManager formatManager;
+			formatManager.registerBasicFormats();
+			
+			for (auto index = nextFile++; index < files.size() && ! shouldExit(); index = nextFile++)
+			{
+				const auto error = renderFile(processor, formatManager, files.getReference(index), settings);
+				
+				if (error.isNotEmpty())
+					++numFailures;
+				
+				const juce::ScopedLock sl(getOutputLock());
+				std::cout << (error.isEmpty() ? (settings.analyseOnly ? "Analysed " : "Rendered ") + files.getReference(index).getFileName() : error) << std::endl;
+				
+				if (error.isEmpty())
+					printResults(processor, settings);
+			}
+			
+			return jobHasFinished;
+		}
+		
+	private:
+		static juce::CriticalSection& getOutputLock()
+		{
+			static juce::CriticalSection lock;
+			return lock;
+		}
+		
+		AwesomeEQAudioProcessor& processor;
+		const juce::Array<juce::File>& files;
+		std::atomic<int>& nextFile;
+		const RenderSettings& settings;
+		std::atomic<int>& numFailures;
+	};
+	
+	void printUsage()
+	{
+		std::cout << "Usage: AwesomeEQRender --output <dir> [--state <file>] [--param \"<id>=<value>\"]..." << std::endl
+				  << "                       [--block <samples>] [--threads <count>] [--parallel] [--metrics] [--meter] <input files>..." << std::endl
+				  << "       AwesomeEQRender --analyse [--state <file>] [--param \"<id>=<value>\"]... [--threads <count>] <input files>..." << std::endl
+				  << "       AwesomeEQRender --benchmark [--seconds <per case>] [--json <file>]" << std::endl;
+	}
+	
+	// One file at a time, each spread across every thread.
+	int renderInParallel (const juce::Array<juce::File>& inputs, const RenderSettings& settings, int numThreads)
+	{
+		AwesomeEQAudioProcessor processor;
+		applySettings(processor, settings);
+		
+		if (! canRenderInParallel(processor))
+			std::cerr << "Linear phase, oversampling, dynamics and metering can't be split into chunks; rendering serially" << std::endl;
+		
+		juce::AudioFormatManager formatManager;
+		formatManager.registerBasicFormats();
+		
+		juce::ThreadPool pool (numThreads);
+		int numFailures = 0;
+		
+		for (auto& input : inputs)
+		{
+			const auto error = renderFile(processor, formatManager, input, settings, &pool, numThreads);
+			
+			if (error.isNotEmpty())
+				++numFailures;
+			
+			std::cout << (error.isEmpty() ? "Rendered " + input.getFileName() : error) << std::endl;
+			
+			// The processor itself only runs when the render fell back to it.
+			if (error.isEmpty() && ! canRenderInParallel(processor))
+				printResults(processor, settings);
+		}
+		
+		return numFailures > 0 ? 1 : 0;
+	}
+	
+	int runBenchmark (const Benchmark::Options& options, const juce::File& jsonFile)
+	{
+		const auto results = Benchmark::run(options);
+		const auto json = juce::JSON::toString(results);
+		
+		if (jsonFile == juce::File())
+			std::cout << json << std::endl;
+		else if (! jsonFile.replaceWithText(json))
+		{
+			std::cerr << "Can't write " << jsonFile.getFullPathName() << std::endl;
+			return 1;
+		}
+		
+		if (Benchmark::hasRealtimeViolations(results))
+		{
+			std::cerr << "processBlock allocated or locked, see the results for details" << std::endl;
+			return 2;
+		}
+		
+		return 0;
+	}
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+	// The parameter tree needs a message manager, but nothing here needs a display.
+	juce::ScopedJuceInitialiser_GUI juceInitialiser;
+	
+	juce::ArgumentList args (argc, argv);
+	RenderSettings settings;
+	juce::Array<juce::File> inputs;
+	int numThreads = juce::SystemStats::getNumCpus();
+	
+	bool benchmark = false;
+	Benchmark::Options benchmarkOptions;
+	juce::File jsonFile;
+	
+	for (int i = 0; i < args.size(); ++i)
+	{
+		const auto argument = args[i].text;
+		const bool hasValue = i + 1 < args.size();
+		
+		if (argument == "--output" && hasValue)
+			settings.outputDirectory = args[++i].resolveAsFile();
+		else if (argument == "--state" && hasValue)
+			args[++i].resolveAsFile().loadFileAsData(settings.state);
+		else if (argument == "--param" && hasValue)
+		{
+			const auto assignment = args[++i].text;
+			settings.parameterValues.set(assignment.upToFirstOccurrenceOf("=", false, false).trim(),
+										 assignment.fromFirstOccurrenceOf("=", false, false).trim());
+		}
+		else if (argument == "--block" && hasValue)
+			settings.blockSize = juce::jmax(1, args[++i].text.getIntValue());
+		else if (argument == "--threads" && hasValue)
+			numThreads = juce::jmax(1, args[++i].text.getIntValue());
+		else if (argument == "--metrics")
+			settings.printMetrics = true;
+		else if (argument == "--meter")
+			settings.printMeter = true;
+		else if (argument == "--analyse")
+			settings.analyseOnly = true;
+		else if (argument == "--parallel")
+			settings.parallel = true;
+		else if (argument == "--benchmark")
+			benchmark = true;
+		else if (argument == "--seconds" && hasValue)
+			benchmarkOptions.secondsPerCase = juce::jmax(0.01, args[++i].text.getDoubleValue());
+		else if (argument == "--json" && hasValue)
+			jsonFile = args[++i].resolveAsFile();
+		else if (argument.startsWith("--"))
+		{
+			printUsage();
+			return 1;
+		}
+		else
+			inputs.add(args[i].resolveAsFile());
+	}
+	
+	if (benchmark)
+		return runBenchmark(benchmarkOptions, jsonFile);
+	
+	if (inputs.isEmpty() || (settings.outputDirectory == juce::File() && ! settings.analyseOnly))
+	{
+		printUsage();
+		return 1;
+	}
+	
+	if (! settings.analyseOnly && ! settings.outputDirectory.createDirectory())
+	{
+		std::cerr << "Can't create " << settings.outputDirectory.getFullPathName() << std::endl;
+		return 1;
+	}
+	
+	if (settings.parallel)
+		return renderInParallel(inputs, settings, numThreads);
+	
+	numThreads = juce::jmin(numThreads, inputs.size());
+	
+	// Processors are created and destroyed here on the message thread; the pool
+	// only ever drives them through prepareToPlay/processBlock.
+	juce::OwnedArray<AwesomeEQAudioProcessor> processors;
+	juce::OwnedArray<RenderJob> jobs;
+	std::atomic<int> nextFile { 0 }, numFailures { 0 };
+	
+	for (int i = 0; i < numThreads; ++i)
+	{
+		auto* processor = processors.add(new AwesomeEQAudioProcessor());
+		applySettings(*processor, settings);
+		jobs.add(new RenderJob(*processor, inputs, nextFile, settings, numFailures));
+	}
+	
+	{
+		juce::ThreadPool pool (numThreads);
+		
+		for (auto* job : jobs)
+			pool.addJob(job, false);
+		
+		for (auto* job : jobs)
+			pool.waitForJobToFinish(job, -1);
+	}
+	
+	return numFailures > 0 ? 1 : 0;
+}
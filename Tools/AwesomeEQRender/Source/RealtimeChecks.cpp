@@ -0,0 +1,156 @@
+/*
+  ==============================================================================
+
+    RealtimeChecks.cpp
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#include "RealtimeChecks.h"
+
+#if JUCE_LINUX && defined (__GLIBC__)
+ #include <cerrno>
+ #include <dlfcn.h>
+ #include <malloc.h>
+ #include <pthread.h>
+
+extern "C"
+{
+	void* __libc_malloc (size_t);
+	void* __libc_calloc (size_t, size_t);
+	void* __libc_realloc (void*, size_t);
+	void* __libc_memalign (size_t, size_t);
+	void __libc_free (void*);
+}
+
+namespace
+{
+	// Plain thread_locals in the executable live in static TLS, so touching
+	// them from inside malloc can't recurse into malloc.
+	thread_local bool isWatching = false;
+	thread_local RealtimeChecks::Counts threadCounts;
+	
+	void countAllocation (void* result) noexcept
+	{
+		if (isWatching && result != nullptr)
+		{
+			++threadCounts.allocations;
+			threadCounts.allocatedBytes += (juce::int64) malloc_usable_size(result);
+		}
+	}
+	
+	using MutexLockFunction = int (*) (pthread_mutex_t*);
+	
+	MutexLockFunction getRealMutexLock()
+	{
+		static const auto function = reinterpret_cast<MutexLockFunction>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+		return function;
+	}
+}
+
+extern "C"
+{
+	void* malloc (size_t size) noexcept
+	{
+		auto* result = __libc_malloc(size);
+		countAllocation(result);
+		return result;
+	}
+	
+	void* calloc (size_t numElements, size_t elementSize) noexcept
+	{
+		auto* result = __libc_calloc(numElements, elementSize);
+		countAllocation(result);
+		return result;
+	}
+	
+	void* realloc (void* pointer, size_t size) noexcept
+	{
+		// The old block counts as freed, in full, and the new one as allocated.
+		if (isWatching && pointer != nullptr)
+		{
+			++threadCounts.deallocations;
+			threadCounts.deallocatedBytes += (juce::int64) malloc_usable_size(pointer);
+		}
+		
+		auto* result = __libc_realloc(pointer, size);
+		countAllocation(result);
+		return result;
+	}
+	
+	// Over-aligned operator new and aligned buffers come through these rather than malloc.
+	void* memalign (size_t alignment, size_t size) noexcept
+	{
+		auto* result = __libc_memalign(alignment, size);
+		countAllocation(result);
+		return result;
+	}
+	
+	void* aligned_alloc (size_t alignment, size_t size) noexcept
+	{
+		return memalign(alignment, size);
+	}
+	
+	int posix_memalign (void** pointer, size_t alignment, size_t size) noexcept
+	{
+		if (alignment % sizeof(void*) != 0 || ! juce::isPowerOfTwo(alignment))
+			return EINVAL;
+		
+		auto* result = memalign(alignment, size);
+		
+		if (result == nullptr && size != 0)
+			return ENOMEM;
+		
+		*pointer = result;
+		return 0;
+	}
+	
+	void free (void* pointer) noexcept
+	{
+		if (isWatching && pointer != nullptr)
+		{
+			++threadCounts.deallocations;
+			threadCounts.deallocatedBytes += (juce::int64) malloc_usable_size(pointer);
+		}
+		
+		__libc_free(pointer);
+	}
+	
+	int pthread_mutex_lock (pthread_mutex_t* mutex) noexcept
+	{
+		if (isWatching)
+			++threadCounts.locks;
+		
+		return getRealMutexLock()(mutex);
+	}
+}
+
+bool RealtimeChecks::isAvailable()		{ return getRealMutexLock() != nullptr; }
+
+RealtimeChecks::Scope::Scope (Counts& countsToAddTo)
+	: counts(countsToAddTo), start(threadCounts)
+{
+	isWatching = true;
+}
+
+RealtimeChecks::Scope::~Scope()
+{
+	isWatching = false;
+	
+	counts.allocations += threadCounts.allocations - start.allocations;
+	counts.deallocations += threadCounts.deallocations - start.deallocations;
+	counts.locks += threadCounts.locks - start.locks;
+	counts.allocatedBytes += threadCounts.allocatedBytes - start.allocatedBytes;
+	counts.deallocatedBytes += threadCounts.deallocatedBytes - start.deallocatedBytes;
+}
+
+#else
+
+bool RealtimeChecks::isAvailable()		{ return false; }
+
+RealtimeChecks::Scope::Scope (Counts& countsToAddTo) : counts(countsToAddTo) {}
+RealtimeChecks::Scope::~Scope() {}
+
+#endif
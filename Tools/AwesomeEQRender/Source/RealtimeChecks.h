@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+
+    RealtimeChecks.h
+    Created: 17 Oct 2026
+    Author:  j-yw
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Counts heap allocations, with their sizes, and mutex locks made by the
+    calling thread while a Scope is alive. The counting works by interposing
+    malloc, its aligned and reallocating variants, and pthread_mutex_lock,
+    which is only done for glibc on Linux; elsewhere isAvailable() returns
+    false and the counts stay at zero.
+*/
+namespace RealtimeChecks
+{
+	struct Counts
+	{
+		juce::int64 allocations { 0 }, deallocations { 0 }, locks { 0 };
+		
+		// Usable sizes, as the allocator rounds them up.
+		juce::int64 allocatedBytes { 0 }, deallocatedBytes { 0 };
+	};
+	
+	bool isAvailable();
+	
+	class Scope
+	{
+	public:
+		explicit Scope (Counts& countsToAddTo);
+		~Scope();
+		
+	private:
+		Counts& counts;
+		Counts start;
+		
+		JUCE_DECLARE_NON_COPYABLE (Scope)
+	};
+}